@@ -4,6 +4,8 @@ else
 	rm bin/*
 fi
 
-g++ -g -O0 -I . -o bin/interrupts_EP interrupts_student1_student2_EP.cpp
-g++ -g -O0 -I . -o bin/interrupts_RR interrupts_student1_student2_RR.cpp
-g++ -g -O0 -I . -o bin/interrupts_EP_RR interrupts_student1_student2_EP_RR.cpp
\ No newline at end of file
+g++ -g -O2 -I . -pthread -o bin/interrupts interrupts_101360700_101268283.cpp
+g++ -g -O2 -I . -pthread -DSIM_INSTRUMENT=1 -o bin/interrupts_instrumented interrupts_101360700_101268283.cpp
+g++ -g -O2 -I . -o bin/trace_to_table interrupts_101360700_101268283_trace_to_table.cpp
+g++ -g -O2 -I . -o bin/bench interrupts_101360700_101268283_bench.cpp
+g++ -g -O2 -I . -o bin/generate_workload interrupts_101360700_101268283_generator.cpp
@@ -0,0 +1,441 @@
+/**
+ * @file interrupts.cpp
+ * @author Nawal Musameh, Shahd Elsaman
+ * Scheduler simulator, the policy is picked on the command line:
+ *   rr     Round Robin (100 ms quantum)
+ *   ep     External Priority (non-preemptive)
+ *   ep_rr  External Priority + Round Robin (100 ms quantum)
+ *   mlfq   Multi-level feedback queue (3 levels, 20/40/80 ms quanta,
+ *          boost every 1000 ms): --levels=20,40,80 sets the number of
+ *          levels and their quanta, --boost=ms the boost period (0 = none)
+ *   sjf    Shortest Job First (non-preemptive)
+ *   srtf   Shortest Remaining Time First (preemptive)
+ *   aging  External Priority with aging (one step per 100 ms READY)
+ * and optionally the memory placement strategy (default best_fit):
+ *   --memory=first_fit|best_fit|worst_fit|buddy|contiguous
+ * and the partition layout (default 40, 25, 15, 10, 8, 2 KB):
+ *   --partitions=40,25,15,10,8,2   or   --partition-file=layout.txt
+ * --trace=file.bin also writes every transition as a binary trace (see
+ * trace_to_table), --no-table skips the execution table file and
+ * --cores=N simulates N CPUs with per-core ready queues (default 1).
+ * --occupancy=file.csv writes the number of processes in each state
+ * every time one of them changes and --memory-series=file.csv the memory
+ * counters (used, free, largest free block, internal fragmentation, ...)
+ * every time memory is assigned or freed (single runs only).
+ * --devices=disk:2:elevator,net:1:fifo adds I/O devices with their
+ * channel count and queue order; the 8th input column picks a device
+ * (0 = the first one) and the optional 9th the block for elevator order.
+ * Built with -DSIM_INSTRUMENT=1 (bin/interrupts_instrumented), a single
+ * run also prints phase timings and event counters on stderr, or writes
+ * them as JSON with --instrument-json=file.json.
+ *
+ * Batch mode runs every input matched by a directory or a glob on a pool
+ * of worker threads and writes Outputs/<name>_execution.txt (and
+ * <name>_memory.txt) for each <name>_input.txt. Without --policy the
+ * policy comes from the file name prefix (RR_, EP_, EP_RR_, MLFQ_, SJF_,
+ * SRTF_, AGING_):
+ *   --batch=Inputs [--jobs=8] [--output-dir=Outputs]
+ *
+ * Sweep mode simulates one input for every combination of quantum, ISR
+ * overhead and partition layout (also on --jobs threads) and prints a CSV
+ * line of metrics per point. Values are lists or first:last:step ranges,
+ * layouts are separated by ';', anything not swept keeps its usual value:
+ *   --sweep-quantum=10:200:10 --sweep-overhead=0,5,10
+ *   --sweep-partitions="40,25,15,10,8,2;25,25,25,25" input.txt
+ */
+
+#include "interrupts_101360700_101268283.hpp"
+#include<atomic>
+#include<thread>
+#include<mutex>
+#include<glob.h>
+#include<sys/stat.h>
+
+// RUN ONE POLICY AND WRITE ITS LOGS
+// A null file name means that output is not written
+template <typename Policy>
+simulation_metrics run_policy(const std::vector<PCB> &list_process,
+                const memory_manager &memory,
+                const char* execution_file, const char* memory_file,
+                const char* trace_file, const simulation_params &params) {
+
+    log_sink execution_log(execution_file);
+    log_sink memory_log(memory_file);
+
+    if (trace_file == nullptr)
+        return run_simulation<Policy>(list_process, memory, execution_log,
+                                      memory_log, nullptr, params);
+
+    trace_sink trace(trace_file);
+    return run_simulation<Policy>(list_process, memory, execution_log,
+                                  memory_log, &trace, params);
+}
+
+//False (with a message on errors) if a process uses a device that is not
+//configured
+bool check_devices(const std::vector<PCB> &list_process,
+                   const simulation_params &params,
+                   std::ostream &errors = std::cerr) {
+    for (const auto &process : list_process) {
+        if (process.io_device >= (int)params.devices.size()) {
+            errors << "Process " << process.PID << " uses I/O device "
+                      << process.io_device << ", only "
+                      << params.devices.size() << " configured.\n";
+            return false;
+        }
+    }
+    return true;
+}
+
+// BATCH MODE
+//Input files matched by pattern: every .txt file of a directory, or the
+//matches of a glob, in sorted order
+std::vector<std::string> batch_inputs(const std::string &pattern) {
+    struct stat info;
+    std::string expanded = pattern;
+    if (stat(pattern.c_str(), &info) == 0 && S_ISDIR(info.st_mode))
+        expanded += "/*.txt";
+
+    std::vector<std::string> inputs;
+    glob_t matches;
+    if (glob(expanded.c_str(), 0, nullptr, &matches) == 0) {
+        for (std::size_t i = 0; i < matches.gl_pathc; i++)
+            inputs.push_back(matches.gl_pathv[i]);
+    }
+    globfree(&matches);
+    return inputs;
+}
+
+//Policy of a corpus file from its name prefix, empty if there is none
+std::string policy_from_name(const std::string &name) {
+    if (name.rfind("EP_RR_", 0) == 0) return "ep_rr";
+    if (name.rfind("RR_", 0) == 0)    return "rr";
+    if (name.rfind("EP_", 0) == 0)    return "ep";
+    if (name.rfind("MLFQ_", 0) == 0)  return "mlfq";
+    if (name.rfind("SJF_", 0) == 0)   return "sjf";
+    if (name.rfind("SRTF_", 0) == 0)  return "srtf";
+    if (name.rfind("AGING_", 0) == 0) return "aging";
+    return "";
+}
+
+//Simulates every input on jobs worker threads, returns the number of
+//inputs that failed
+int run_batch(const std::vector<std::string> &inputs, const std::string &policy,
+              const memory_manager &memory, const simulation_params &params,
+              const std::string &output_dir, unsigned int jobs) {
+
+    std::atomic<std::size_t> next_input(0);
+    std::atomic<int>         failures(0);
+    std::mutex               report;
+
+    auto worker = [&]() {
+        for (std::size_t i = next_input++; i < inputs.size(); i = next_input++) {
+
+            std::string name = inputs[i].substr(inputs[i].find_last_of('/') + 1);
+            std::size_t suffix = name.rfind("_input.txt");
+            if (suffix == std::string::npos) suffix = name.rfind(".txt");
+            name = name.substr(0, suffix);
+
+            std::string file_policy = policy.empty() ? policy_from_name(name)
+                                                     : policy;
+            std::vector<PCB> list_process;
+            std::ostringstream error;   // reason the input failed
+
+            bool ok = true;
+            if (!with_policy(file_policy, [](auto) {})) {
+                error << "no policy prefix (RR_, EP_, EP_RR_, MLFQ_, SJF_, "
+                         "SRTF_, AGING_) in the file name, use --policy.\n";
+                ok = false;
+            }
+
+            ok = ok && load_processes(inputs[i].c_str(), list_process, error) &&
+                check_devices(list_process, params, error) &&
+                with_policy(file_policy, [&](auto p) {
+                    typedef decltype(p) Policy;
+                    std::string execution = output_dir + "/" + name + "_execution.txt";
+                    std::string memory_log = output_dir + "/" + name + "_memory.txt";
+
+                    run_policy<Policy>(list_process, memory, execution.c_str(),
+                                       Policy::memory_file ? memory_log.c_str()
+                                                           : nullptr,
+                                       nullptr, params);
+                });
+
+            std::lock_guard<std::mutex> lock(report);
+            if (ok) {
+                std::cout << inputs[i] << " -> " << output_dir << "/"
+                          << name << "_execution.txt\n";
+            } else {
+                std::cerr << inputs[i] << ": " << error.str();
+                failures++;
+            }
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (unsigned int j = 0; j < jobs; j++)
+        pool.emplace_back(worker);
+    for (auto &thread : pool)
+        thread.join();
+
+    return failures;
+}
+
+// SWEEP MODE
+//A list of values (10,20,50) or a first:last:step range (10:200:10)
+bool parse_sweep_values(const std::string &spec, std::vector<int> &values) {
+    std::vector<unsigned int> parsed;
+    std::size_t colon = spec.find(':');
+
+    if (colon == std::string::npos) {
+        if (!parse_partition_spec(spec, parsed)) return false;
+    } else {
+        std::vector<unsigned int> range;
+        std::string bounds = spec;
+        std::replace(bounds.begin(), bounds.end(), ':', ',');
+        if (!parse_partition_spec(bounds, range) || range.size() != 3 ||
+            range[2] == 0 || range[0] > range[1])
+            return false;
+        // 64-bit so the last step cannot wrap around past range[1]
+        for (unsigned long long v = range[0]; v <= range[1]; v += range[2])
+            parsed.push_back(v);
+    }
+
+    // values are ints, where a negative one would mean "policy default"
+    for (unsigned int v : parsed)
+        if (v > INT_MAX) return false;
+
+    values.assign(parsed.begin(), parsed.end());
+    return true;
+}
+
+//Partition layouts separated by ';'
+bool parse_sweep_layouts(const std::string &spec,
+                         std::vector<std::vector<unsigned int>> &layouts) {
+    std::stringstream specs(spec);
+    std::string layout;
+    layouts.clear();
+
+    while (std::getline(specs, layout, ';')) {
+        std::vector<unsigned int> sizes;
+        if (!parse_partition_spec(layout, sizes)) return false;
+        layouts.push_back(sizes);
+    }
+    return !layouts.empty();
+}
+
+//Simulates every point of the sweep on jobs worker threads and prints the
+//CSV in sweep order
+void run_sweep(const std::vector<PCB> &list_process,
+               const simulation_config &base,
+               const std::vector<int> &quanta,
+               const std::vector<int> &overheads,
+               const std::vector<std::vector<unsigned int>> &layouts,
+               unsigned int jobs) {
+
+    std::vector<simulation_config> points;
+    for (const auto &layout : layouts)
+        for (int quantum : quanta)
+            for (int overhead : overheads) {
+                simulation_config point = base;
+                point.partition_sizes     = layout;
+                point.params.quantum      = quantum;
+                point.params.isr_overhead = overhead;
+                points.push_back(point);
+            }
+
+    std::vector<simulation_metrics> results(points.size());
+    std::atomic<std::size_t> next_point(0);
+
+    auto worker = [&]() {
+        for (std::size_t i = next_point++; i < points.size(); i = next_point++)
+            results[i] = run_simulation(points[i], list_process).metrics;
+    };
+
+    std::vector<std::thread> pool;
+    for (unsigned int j = 0; j < jobs; j++)
+        pool.emplace_back(worker);
+    for (auto &thread : pool)
+        thread.join();
+
+    std::cout << "policy,quantum,isr_overhead,partitions,processes,"
+                 "throughput,avg_wait,avg_turnaround,avg_response,"
+                 "p99_wait,p99_turnaround,p99_response,cpu_utilization\n";
+
+    for (std::size_t i = 0; i < points.size(); i++) {
+        const simulation_config  &point = points[i];
+        const simulation_metrics &m     = results[i];
+
+        std::string layout;
+        for (unsigned int size : point.partition_sizes)
+            layout += (layout.empty() ? "" : " ") + std::to_string(size);
+
+        with_policy(point.policy, [&](auto p) {
+            typedef decltype(p) Policy;
+            std::cout << point.policy << ","
+                      << point.params.quantum_of<Policy>() << ","
+                      << point.params.isr_overhead_of<Policy>() << ","
+                      << layout << "," << m.processes << ","
+                      << m.throughput << "," << m.avg_wait << ","
+                      << m.avg_turnaround << "," << m.avg_response << ","
+                      << m.wait.p99 << "," << m.turnaround.p99 << ","
+                      << m.response.p99 << "," << m.cpu_utilization << "\n";
+        });
+    }
+}
+
+// MAIN
+int main(int argc, char** argv) {
+
+    std::string policy;
+    memory_strategy strategy = BEST_FIT;
+    std::vector<unsigned int> partition_sizes = default_partition_sizes();
+    std::string trace_file;
+    std::string instrument_file;
+    std::string occupancy_file;
+    std::string memory_series_file;
+    std::string batch;
+    std::string output_dir = "Outputs";
+    unsigned int jobs = std::max(1u, std::thread::hardware_concurrency());
+    simulation_params params;
+    std::vector<int> quanta(1, -1), overheads(1, -1);
+    std::vector<std::vector<unsigned int>> layouts;
+    bool sweep = false;
+    bool table = true;
+    bool valid = true;
+    const char* input = nullptr;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg.rfind("--policy=", 0) == 0)
+            policy = arg.substr(9);
+        else if (arg.rfind("--memory=", 0) == 0)
+            valid = valid && parse_memory_strategy(arg.substr(9), strategy);
+        else if (arg.rfind("--partitions=", 0) == 0)
+            valid = valid && parse_partition_spec(arg.substr(13), partition_sizes);
+        else if (arg.rfind("--partition-file=", 0) == 0)
+            valid = valid && load_partition_file(arg.substr(17).c_str(),
+                                                 partition_sizes);
+        else if (arg.rfind("--trace=", 0) == 0)
+            trace_file = arg.substr(8);
+        else if (arg.rfind("--instrument-json=", 0) == 0)
+            instrument_file = arg.substr(18);
+        else if (arg.rfind("--occupancy=", 0) == 0)
+            occupancy_file = arg.substr(12);
+        else if (arg.rfind("--memory-series=", 0) == 0)
+            memory_series_file = arg.substr(16);
+        else if (arg == "--no-table")
+            table = false;
+        else if (arg.rfind("--devices=", 0) == 0)
+            valid = valid && parse_device_spec(arg.substr(10), params.devices);
+        else if (arg.rfind("--levels=", 0) == 0)
+            valid = valid && parse_level_quanta(arg.substr(9), params.level_quanta);
+        else if (arg.rfind("--boost=", 0) == 0) {
+            unsigned int boost = 0;
+            valid = valid && parse_unsigned(arg.substr(8), boost) && boost <= INT_MAX;
+            if (valid) params.boost_interval = static_cast<int>(boost);
+        }
+        else if (arg.rfind("--cores=", 0) == 0)
+            valid = valid && parse_unsigned(arg.substr(8), params.cores) &&
+                    params.cores > 0;
+        else if (arg.rfind("--batch=", 0) == 0)
+            batch = arg.substr(8);
+        else if (arg.rfind("--jobs=", 0) == 0)
+            valid = valid && parse_unsigned(arg.substr(7), jobs) && jobs > 0;
+        else if (arg.rfind("--output-dir=", 0) == 0)
+            output_dir = arg.substr(13);
+        else if (arg.rfind("--sweep-quantum=", 0) == 0)
+            sweep = true, valid = valid && parse_sweep_values(arg.substr(16), quanta);
+        else if (arg.rfind("--sweep-overhead=", 0) == 0)
+            sweep = true, valid = valid && parse_sweep_values(arg.substr(17), overheads);
+        else if (arg.rfind("--sweep-partitions=", 0) == 0)
+            sweep = true, valid = valid && parse_sweep_layouts(arg.substr(19), layouts);
+        else
+            input = argv[i];
+    }
+
+    bool known_policy = with_policy(policy, [](auto) {});
+    bool single_run   = batch.empty() && input != nullptr && known_policy;
+    bool batch_run    = !batch.empty() && input == nullptr &&
+                        (policy.empty() || known_policy);
+
+    if (!valid || (!single_run && !batch_run)) {
+        std::cout << "ERROR!\nUsage: ./interrupts --policy=rr|ep|ep_rr|mlfq|sjf|srtf|aging "
+                     "[--memory=first_fit|best_fit|worst_fit|buddy|contiguous] "
+                     "[--partitions=40,25,... | --partition-file=layout.txt] "
+                     "[--trace=file.bin] [--occupancy=file.csv] "
+                     "[--memory-series=file.csv] "
+                     "[--no-table] [--cores=N] [--levels=20,40,80] [--boost=ms] "
+                     "[--devices=disk:2:elevator,...] input.txt\n"
+                     "       ./interrupts --batch=dir|glob [--policy=...] "
+                     "[--jobs=N] [--output-dir=Outputs] [memory options]\n"
+                     "       ./interrupts --policy=... [--sweep-quantum=a:b:step] "
+                     "[--sweep-overhead=a,b,...] [--sweep-partitions=\"l1;l2\"] "
+                     "[--jobs=N] [memory options] input.txt\n";
+        return -1;
+    }
+
+    memory_manager memory(partition_sizes, strategy);
+
+    if (batch_run) {
+        std::vector<std::string> inputs = batch_inputs(batch);
+        if (inputs.empty()) {
+            std::cerr << "No input files match " << batch << "\n";
+            return -1;
+        }
+        struct stat info;
+        if (stat(output_dir.c_str(), &info) != 0 || !S_ISDIR(info.st_mode)) {
+            std::cerr << "Output directory " << output_dir << " does not exist.\n";
+            return -1;
+        }
+        return run_batch(inputs, policy, memory, params, output_dir, jobs) == 0
+            ? 0 : -1;
+    }
+
+    std::vector<PCB> list_process;
+    if (!load_processes(input, list_process) ||
+        !check_devices(list_process, params))
+        return -1;
+
+    if (sweep) {
+        simulation_config base;
+        base.policy          = policy;
+        base.memory          = strategy;
+        base.partition_sizes = partition_sizes;
+        base.params          = params;
+
+        if (layouts.empty()) layouts.push_back(partition_sizes);
+        run_sweep(list_process, base, quanta, overheads, layouts, jobs);
+        return 0;
+    }
+
+    const char* trace = trace_file.empty() ? nullptr : trace_file.c_str();
+
+    log_sink occupancy(occupancy_file.empty() ? nullptr : occupancy_file.c_str());
+    if (!occupancy_file.empty()) params.occupancy = &occupancy;
+
+    log_sink memory_series(memory_series_file.empty() ? nullptr
+                                                      : memory_series_file.c_str());
+    if (!memory_series_file.empty()) params.memory_series = &memory_series;
+
+    simulation_metrics metrics;
+
+    with_policy(policy, [&](auto p) {
+        typedef decltype(p) Policy;
+        metrics = run_policy<Policy>(list_process, memory,
+                                     table ? Policy::execution_file : nullptr,
+                                     Policy::memory_file, trace, params);
+    });
+
+    if (SIM_INSTRUMENT && instrument_file.empty())
+        std::cerr << print_instrumentation(metrics.probes, false);
+
+    if (!instrument_file.empty()) {
+        if (!SIM_INSTRUMENT)
+            std::cerr << "Built without SIM_INSTRUMENT, no instrumentation.\n";
+        std::ofstream out(instrument_file);
+        out << print_instrumentation(metrics.probes, true);
+    }
+
+    return 0;
+}
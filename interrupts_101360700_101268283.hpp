@@ -17,9 +17,25 @@
 #include<sstream>
 #include<iomanip>
 #include<algorithm>
+#include<deque>
+#include<set>
+#include<map>
+#include<unordered_map>
+#include<climits>
+#include<cmath>
+#include<chrono>
+#include<cstdint>
+#include<cctype>
+#include<charconv>
+#include<cstring>
+#include<string_view>
+#include<fcntl.h>
+#include<sys/mman.h>
+#include<sys/stat.h>
+#include<unistd.h>
 
 // PROCESS STATES
-enum states {
+enum states : unsigned char {
     NEW,
     READY,
     RUNNING,
@@ -28,6 +44,8 @@ enum states {
     NOT_ASSIGNED
 };
 
+const int STATE_COUNT = NOT_ASSIGNED + 1;
+
 inline std::ostream& operator<<(std::ostream& os, const enum states& s) {
     std::string state_names[] = {
         "NEW",
@@ -43,19 +61,76 @@ inline std::ostream& operator<<(std::ostream& os, const enum states& s) {
 // ================================
 // MEMORY PARTITIONS
 // ================================
-struct memory_partition{
-    unsigned int    partition_number;
-    unsigned int    size;
-    int             occupied;
-} memory_paritions[] = {
-    {1, 40, -1},
-    {2, 25, -1},
-    {3, 15, -1},
-    {4, 10, -1},
-    {5, 8, -1},
-    {6, 2, -1}
+// Partition table as a structure of arrays: partition i is numbered i + 1
+// and the free-space scans only walk the size array
+struct partition_table {
+    std::vector<unsigned int>   size;
+    std::vector<int>            occupied;   // PID, -1 when free
+};
+
+// Memory counters (KB), kept up to date by the memory manager on every
+// assign / free instead of being recomputed from the process table
+struct memory_usage {
+    unsigned int        total        = 0;   // memory under management
+    unsigned int        used         = 0;   // requested by resident processes
+    unsigned int        allocated    = 0;   // partitions / blocks handed out
+    unsigned int        largest_free = 0;   // largest request that fits now
+    unsigned int        resident     = 0;   // processes holding memory
+    unsigned long long  rejections   = 0;   // requests that did not fit (see fits)
+
+    unsigned int free() const { return total - allocated; }
+    unsigned int internal_fragmentation() const { return allocated - used; }
 };
 
+//Default partition layout (KB)
+inline std::vector<unsigned int> default_partition_sizes() {
+    return {40, 25, 15, 10, 8, 2};
+}
+
+//Parse a whole string of digits into value, false if it has anything else
+//or does not fit in an unsigned int
+inline bool parse_unsigned(const std::string &text, unsigned int &value) {
+    const char* end = text.data() + text.size();
+    auto [stop, error] = std::from_chars(text.data(), end, value);
+    return !text.empty() && error == std::errc() && stop == end;
+}
+
+//Parse a partition layout such as "40, 25, 15, 10, 8, 2". Sizes may be
+//separated by commas, spaces or new lines; '#' starts a comment.
+inline bool parse_partition_spec(const std::string &spec,
+                                 std::vector<unsigned int> &sizes) {
+    std::vector<unsigned int> parsed;
+    std::stringstream lines(spec);
+    std::string line, field;
+
+    while (std::getline(lines, line)) {
+        line = line.substr(0, line.find('#'));
+        std::replace(line.begin(), line.end(), ',', ' ');
+
+        std::stringstream fields(line);
+        unsigned int size;
+        while (fields >> field) {
+            if (!parse_unsigned(field, size)) return false;
+            parsed.push_back(size);
+        }
+    }
+
+    if (parsed.empty()) return false;
+    sizes = parsed;
+    return true;
+}
+
+//Load a partition layout from a file (same format as above)
+inline bool load_partition_file(const char* filename,
+                                std::vector<unsigned int> &sizes) {
+    std::ifstream file(filename);
+    if (!file.is_open()) return false;
+
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    return parse_partition_spec(buffer.str(), sizes);
+}
+
 // PCB (EXTENDED VERSION)
 struct PCB{
     int             PID;
@@ -72,6 +147,8 @@ struct PCB{
     //ADDED FOR FULL SIMULATOR
     unsigned int    remaining_io_time;   // for WAITING state
     int             priority;            // for priority scheduling
+    int             io_device;           // -1 = no device (no contention)
+    unsigned int    io_block;            // position for elevator devices
 
     //METRICS TRACKING 
     unsigned int    completion_time;
@@ -95,7 +172,7 @@ inline std::vector<std::string> split_delim(std::string input, std::string delim
 }
 
 // PCB PRINTING
-inline std::string print_PCB(std::vector<PCB> _PCB) {
+inline std::string print_PCB(const std::vector<PCB> &_PCB) {
     const int tableWidth = 83;
     std::stringstream buffer;
 
@@ -127,7 +204,7 @@ inline std::string print_PCB(std::vector<PCB> _PCB) {
     return buffer.str();
 }
 
-inline std::string print_PCB(PCB _PCB) {
+inline std::string print_PCB(const PCB &_PCB) {
     return print_PCB(std::vector<PCB>{_PCB});
 }
 
@@ -147,15 +224,50 @@ inline std::string print_exec_header() {
     return buffer.str();
 }
 
+//Right-aligns len characters of text in a field of width characters
+//(wider text is not cut, like std::setw)
+inline char* pad_field(char* out, const char* text, std::size_t len,
+                       std::size_t width) {
+    for (std::size_t i = len; i < width; i++) *out++ = ' ';
+    std::memcpy(out, text, len);
+    return out + len;
+}
+
+inline char* pad_number(char* out, long long value, std::size_t width) {
+    char digits[24];
+    char* end = std::to_chars(digits, digits + sizeof(digits), value).ptr;
+    return pad_field(out, digits, end - digits, width);
+}
+
+inline char* pad_state(char* out, states s, std::size_t width) {
+    static const char* const state_names[] = {
+        "NEW", "READY", "RUNNING", "WAITING", "TERMINATED", "NOT_ASSIGNED"
+    };
+    return pad_field(out, state_names[s], std::strlen(state_names[s]), width);
+}
+
+//Writes one execution log row into out (at least EXEC_ROW_MAX chars),
+//returns the end of the row
+const std::size_t EXEC_ROW_MAX = 96;
+
+inline char* format_exec_status(char* out, unsigned int current_time, int PID,
+                                states old_state, states new_state) {
+    *out++ = '|';
+    out = pad_number(out, current_time, 18);
+    out = pad_field(out, " |", 2, 2);
+    out = pad_number(out, PID, 3);
+    out = pad_field(out, " |", 2, 2);
+    out = pad_state(out, old_state, 10);
+    out = pad_field(out, " |", 2, 2);
+    out = pad_state(out, new_state, 10);
+    return pad_field(out, " |\n", 3, 3);
+}
+
 inline std::string print_exec_status(unsigned int current_time, int PID,
                                      states old_state, states new_state) {
-    std::stringstream buffer;
-    buffer << "|"
-           << std::setw(18) << current_time << " |"
-           << std::setw(3)  << PID << " |"
-           << std::setw(10) << old_state << " |"
-           << std::setw(10) << new_state << " |\n";
-    return buffer.str();
+    char row[EXEC_ROW_MAX];
+    char* end = format_exec_status(row, current_time, PID, old_state, new_state);
+    return std::string(row, end);
 }
 
 inline std::string print_exec_footer() {
@@ -176,49 +288,530 @@ inline void write_output(std::string execution, const char* filename) {
         std::cerr << "Error opening file!\n";
     }
 }
+
+// LOG SINK
+// Rows are formatted straight into a fixed buffer that is written to the
+// file (or appended to a captured string) in chunks while the simulation
+// runs. A sink without either discards everything (e.g. the memory log of
+// EP).
+class log_sink {
+public:
+    log_sink() {}
+
+    explicit log_sink(const char* filename) {
+        if (filename == nullptr) return;
+        file.open(filename, std::ios::binary);
+        if (!file.is_open())
+            std::cerr << "Error opening file!\n";
+    }
+
+    //Write to an already open stream (e.g. std::cout)
+    explicit log_sink(std::ostream &out) : stream(&out) {}
+
+    //Collect the output in text instead of a file
+    void capture(std::string &text) {
+        captured = &text;
+    }
+
+    ~log_sink() { flush(); }
+
+    log_sink(const log_sink &) = delete;
+    log_sink &operator=(const log_sink &) = delete;
+
+    void write(const char* data, std::size_t n) {
+        if (!active()) return;
+        if (used + n > sizeof(buffer)) flush();
+        if (n > sizeof(buffer)) {
+            output(data, n);
+            return;
+        }
+        std::memcpy(buffer + used, data, n);
+        used += n;
+    }
+
+    void write(const std::string &text) { write(text.data(), text.size()); }
+
+    //Execution log row, same layout as print_exec_status
+    void exec_status(unsigned int current_time, int PID,
+                     states old_state, states new_state) {
+        if (!active()) return;
+        reserve(EXEC_ROW_MAX);
+        used = format_exec_status(buffer + used, current_time, PID,
+                                  old_state, new_state) - buffer;
+    }
+
+    //Memory log row: "Time <t> | Used Memory: <used> KB"
+    void memory_status(unsigned int current_time, unsigned int used_memory) {
+        if (!active()) return;
+        reserve(64);
+        char* out = buffer + used;
+        out = pad_field(out, "Time ", 5, 5);
+        out = pad_number(out, current_time, 0);
+        out = pad_field(out, " | Used Memory: ", 16, 16);
+        out = pad_number(out, used_memory, 0);
+        out = pad_field(out, " KB\n", 4, 4);
+        used = out - buffer;
+    }
+
+    //Memory series row: "<t>,<used>,<free>,<allocated>,<largest_free>,
+    //<internal_fragmentation>,<resident>,<rejections>"
+    void memory_usage_row(unsigned int current_time, const memory_usage &usage) {
+        if (!active()) return;
+        reserve(8 * 24);
+        const unsigned long long fields[] = {
+            usage.used, usage.free(), usage.allocated, usage.largest_free,
+            usage.internal_fragmentation(), usage.resident, usage.rejections
+        };
+        char* out = buffer + used;
+        out = pad_number(out, current_time, 0);
+        for (unsigned long long field : fields) {
+            out = pad_field(out, ",", 1, 1);
+            out = pad_number(out, field, 0);
+        }
+        out = pad_field(out, "\n", 1, 1);
+        used = out - buffer;
+    }
+
+    //State occupancy row: "<t>,<new>,<ready>,<running>,<waiting>,<terminated>"
+    void occupancy(unsigned int current_time, const std::size_t* counts) {
+        if (!active()) return;
+        reserve(6 * 24);
+        char* out = buffer + used;
+        out = pad_number(out, current_time, 0);
+        for (int s = NEW; s <= TERMINATED; s++) {
+            out = pad_field(out, ",", 1, 1);
+            out = pad_number(out, counts[s], 0);
+        }
+        out = pad_field(out, "\n", 1, 1);
+        used = out - buffer;
+    }
+
+    void flush() {
+        if (used > 0) output(buffer, used);
+        used = 0;
+    }
+
+private:
+    bool active() const {
+        return captured != nullptr || stream != nullptr || file.is_open();
+    }
+
+    void output(const char* data, std::size_t n) {
+        if (captured != nullptr)    captured->append(data, n);
+        else if (stream != nullptr) stream->write(data, n);
+        else                        file.write(data, n);
+    }
+
+    void reserve(std::size_t n) {
+        if (used + n > sizeof(buffer)) flush();
+    }
+
+    std::ofstream   file;
+    std::string     *captured = nullptr;
+    std::ostream    *stream   = nullptr;
+    char            buffer[1 << 16];
+    std::size_t     used = 0;
+};
+
+// BINARY TRACE
+// Compact alternative to the execution table: an 8 byte magic followed by
+// one fixed-width little-endian record per state transition
+//   u32 time | i32 PID | u8 old state | u8 new state | u16 reserved (0)
+const char        TRACE_MAGIC[8]    = {'S', 'Y', 'S', 'C', 'T', 'R', 'C', '1'};
+const std::size_t TRACE_RECORD_SIZE = 12;
+
+struct trace_record {
+    unsigned int    time;
+    int             PID;
+    states          old_state;
+    states          new_state;
+};
+
+inline void encode_trace_record(char* out, const trace_record &record) {
+    unsigned int PID = static_cast<unsigned int>(record.PID);
+    for (int i = 0; i < 4; i++) {
+        out[i]     = static_cast<char>((record.time >> (8 * i)) & 0xFF);
+        out[4 + i] = static_cast<char>((PID >> (8 * i)) & 0xFF);
+    }
+    out[8]  = static_cast<char>(record.old_state);
+    out[9]  = static_cast<char>(record.new_state);
+    out[10] = 0;
+    out[11] = 0;
+}
+
+//False if a state byte is not a valid state
+inline bool decode_trace_record(const char* in, trace_record &record) {
+    unsigned int time = 0, PID = 0;
+    for (int i = 0; i < 4; i++) {
+        time |= static_cast<unsigned int>(static_cast<unsigned char>(in[i])) << (8 * i);
+        PID  |= static_cast<unsigned int>(static_cast<unsigned char>(in[4 + i])) << (8 * i);
+    }
+
+    unsigned char old_state = in[8], new_state = in[9];
+    if (old_state > NOT_ASSIGNED || new_state > NOT_ASSIGNED) return false;
+
+    record = {time, static_cast<int>(PID),
+              static_cast<states>(old_state), static_cast<states>(new_state)};
+    return true;
+}
+
+//Binary trace writer, buffered through a log_sink
+class trace_sink {
+public:
+    explicit trace_sink(const char* filename) : sink(filename) {
+        sink.write(TRACE_MAGIC, sizeof(TRACE_MAGIC));
+    }
+
+    void record(unsigned int current_time, int PID,
+                states old_state, states new_state) {
+        char bytes[TRACE_RECORD_SIZE];
+        encode_trace_record(bytes, {current_time, PID, old_state, new_state});
+        sink.write(bytes, sizeof(bytes));
+    }
+
+private:
+    log_sink sink;
+};
+
 //--------------------------------------------FUNCTIONS FOR THE "OS"-------------------------------------
 
-//Assign memory partition to program
 // MEMORY MANAGEMENT
-inline bool assign_memory(PCB &program) {
-    for(int i = 5; i >= 0; i--) {
-        if(program.size <= memory_paritions[i].size &&
-           memory_paritions[i].occupied == -1) {
-            memory_paritions[i].occupied = program.PID;
-            program.partition_number = memory_paritions[i].partition_number;
+// Placement strategies of the memory manager. The fit strategies place a
+// process in one of the fixed partitions, BUDDY and CONTIGUOUS carve
+// blocks out of one region as large as all the partitions together (for
+// those, a PCB's partition_number is the start address of its block).
+enum memory_strategy {
+    FIRST_FIT,      // lowest numbered free partition that fits
+    BEST_FIT,       // smallest free partition that fits
+    WORST_FIT,      // largest free partition
+    BUDDY,          // power-of-two buddy blocks
+    CONTIGUOUS      // variable-size blocks, best-fit hole, holes coalesce
+};
+
+//Parse a strategy name as given on the command line (e.g. "best_fit")
+inline bool parse_memory_strategy(const std::string &name,
+                                  memory_strategy &strategy) {
+    const std::pair<const char*, memory_strategy> names[] = {
+        {"first_fit",  FIRST_FIT},
+        {"best_fit",   BEST_FIT},
+        {"worst_fit",  WORST_FIT},
+        {"buddy",      BUDDY},
+        {"contiguous", CONTIGUOUS}
+    };
+    for (const auto &entry : names) {
+        if (name == entry.first) {
+            strategy = entry.second;
             return true;
         }
     }
     return false;
 }
 
-//Free a memory partition
-inline bool free_memory(PCB &program){
-    for(int i = 5; i >= 0; i--) {
-        if(program.PID == memory_paritions[i].occupied) {
-            memory_paritions[i].occupied = -1;
-            program.partition_number = -1;
-            return true;
+//Memory manager: owns the partitions and keeps the free space indexed so
+//placement and release are O(log n) in the number of partitions / blocks
+class memory_manager {
+public:
+    explicit memory_manager(const std::vector<unsigned int> &partition_sizes =
+                                default_partition_sizes(),
+                            memory_strategy strategy = BEST_FIT)
+        : strategy(strategy) {
+
+        partitions.size = partition_sizes;
+        partitions.occupied.assign(partition_sizes.size(), -1);
+
+        unsigned int total = 0;
+        for (unsigned int size : partition_sizes)
+            total += size;
+        counters.total = total;
+
+        if (strategy == BUDDY) {
+            // largest power of two that fits in the configured memory
+            unsigned int max_order = 0;
+            while (max_order < 31 && (2u << max_order) <= total) max_order++;
+            buddy_free.resize(max_order + 1);
+            counters.total = (total > 0) ? (1u << max_order) : 0;
+            if (total > 0) buddy_free[max_order].insert(0);
+        }
+        else if (strategy == CONTIGUOUS) {
+            if (total > 0) add_hole(0, total);
         }
+        else {
+            while (leaves < partitions.size.size()) leaves *= 2;
+            fit_tree.assign(2 * leaves, 0);
+            for (std::size_t i = 0; i < partitions.size.size(); i++)
+                mark_free(i);
+        }
+        update_largest_free();
     }
-    return false;
-}
 
-//Convert a list of strings into a PCB
+    //Assign size KB to process PID, false if nothing fits right now.
+    //partition_number receives the partition (or block start).
+    bool assign_memory(int PID, unsigned int size, int &partition_number) {
+        bool assigned;
+        switch (strategy) {
+            case BUDDY:      assigned = assign_buddy(size, partition_number);      break;
+            case CONTIGUOUS: assigned = assign_contiguous(size, partition_number); break;
+            default:         assigned = assign_partition(PID, size, partition_number);
+        }
+
+        if (!assigned) {
+            counters.rejections++;
+            return false;
+        }
+        requested[partition_number] = size;
+        counters.used += size;
+        counters.resident++;
+        update_largest_free();
+        return true;
+    }
+
+    bool assign_memory(PCB &program) {
+        return assign_memory(program.PID, program.size, program.partition_number);
+    }
+
+    //True if assign_memory(size) would succeed right now, O(1). Callers
+    //that wait for memory check this before asking again, so each waiting
+    //process counts as one rejection however often it is retried.
+    bool fits(unsigned int size) const {
+        switch (strategy) {
+            case BUDDY:      return counters.largest_free > 0 &&
+                                    size <= counters.largest_free;
+            case CONTIGUOUS: return std::max(size, 1u) <= counters.largest_free;
+            default:         return !free_by_size.empty() &&
+                                    size <= counters.largest_free;
+        }
+    }
+
+    //Free the memory held by process PID
+    bool free_memory(int PID, int &partition_number) {
+        if (partition_number == -1) return false;
+
+        switch (strategy) {
+            case BUDDY:      free_buddy(partition_number);      break;
+            case CONTIGUOUS: free_contiguous(partition_number); break;
+            default: {
+                std::size_t i = partition_number - 1;
+                if (partitions.occupied[i] != PID) return false;
+                mark_free(i);
+            }
+        }
+
+        auto held = requested.find(partition_number);
+        counters.used -= held->second;
+        counters.resident--;
+        requested.erase(held);
+        update_largest_free();
+
+        partition_number = -1;
+        return true;
+    }
+
+    bool free_memory(PCB &program) {
+        return free_memory(program.PID, program.partition_number);
+    }
+
+    //Current counters, O(1)
+    const memory_usage &usage() const { return counters; }
+
+private:
+    // largest free partition / block / hole, read off the free-space index
+    void update_largest_free() {
+        if (strategy == BUDDY) {
+            counters.largest_free = 0;
+            for (std::size_t j = buddy_free.size(); j-- > 0;) {
+                if (!buddy_free[j].empty()) {
+                    counters.largest_free = 1u << j;
+                    break;
+                }
+            }
+        }
+        else if (strategy == CONTIGUOUS)
+            counters.largest_free = holes_by_size.empty()
+                ? 0 : holes_by_size.rbegin()->first;
+        else
+            counters.largest_free = free_by_size.empty()
+                ? 0 : free_by_size.rbegin()->first;
+    }
+
+    // ---- fixed partitions ----
+    void mark_free(std::size_t i) {
+        if (partitions.occupied[i] != -1)
+            counters.allocated -= partitions.size[i];
+        partitions.occupied[i] = -1;
+        free_by_size.insert({partitions.size[i], i});
+        set_leaf(i, partitions.size[i] + 1);
+    }
+
+    void mark_used(std::size_t i, int PID) {
+        partitions.occupied[i] = PID;
+        counters.allocated += partitions.size[i];
+        free_by_size.erase({partitions.size[i], i});
+        set_leaf(i, 0);
+    }
+
+    // fit_tree holds (largest free size + 1) per range, 0 when all used
+    void set_leaf(std::size_t i, unsigned int value) {
+        std::size_t node = i + leaves;
+        fit_tree[node] = value;
+        for (node /= 2; node > 0; node /= 2)
+            fit_tree[node] = std::max(fit_tree[2 * node], fit_tree[2 * node + 1]);
+    }
+
+    bool assign_partition(int PID, unsigned int size, int &partition_number) {
+        std::size_t chosen;
+
+        if (strategy == FIRST_FIT) {
+            // walk down to the leftmost partition with enough room
+            if (fit_tree.empty() || fit_tree[1] < size + 1) return false;
+            std::size_t node = 1;
+            while (node < leaves)
+                node = (fit_tree[2 * node] >= size + 1) ? 2 * node
+                                                                : 2 * node + 1;
+            chosen = node - leaves;
+        }
+        else if (strategy == BEST_FIT) {
+            auto it = free_by_size.lower_bound({size, 0});
+            if (it == free_by_size.end()) return false;
+            chosen = it->second;
+        }
+        else {
+            if (free_by_size.empty() ||
+                free_by_size.rbegin()->first < size) return false;
+            chosen = free_by_size.rbegin()->second;
+        }
+
+        mark_used(chosen, PID);
+        partition_number = chosen + 1;
+        return true;
+    }
+
+    // ---- buddy system ----
+    bool assign_buddy(unsigned int size, int &partition_number) {
+        unsigned int order = 0;
+        while (order < 31 && (1u << order) < size) order++;
+        if ((1u << order) < size) return false;     // above 2^31 KB
+
+        unsigned int j = order;
+        while (j < buddy_free.size() && buddy_free[j].empty()) j++;
+        if (j >= buddy_free.size()) return false;
+
+        unsigned int start = *buddy_free[j].begin();
+        buddy_free[j].erase(buddy_free[j].begin());
+
+        // split down to the requested order, keeping the lower halves
+        while (j > order) {
+            j--;
+            buddy_free[j].insert(start + (1u << j));
+        }
+
+        allocated[start] = order;
+        counters.allocated += 1u << order;
+        partition_number = start;
+        return true;
+    }
+
+    void free_buddy(unsigned int start) {
+        unsigned int order = allocated[start];
+        allocated.erase(start);
+        counters.allocated -= 1u << order;
+
+        // coalesce with the buddy as long as it is free
+        while (order + 1 < buddy_free.size()) {
+            auto buddy = buddy_free[order].find(start ^ (1u << order));
+            if (buddy == buddy_free[order].end()) break;
+            buddy_free[order].erase(buddy);
+            start &= ~(1u << order);
+            order++;
+        }
+        buddy_free[order].insert(start);
+    }
+
+    // ---- contiguous allocation ----
+    void add_hole(unsigned int start, unsigned int size) {
+        holes[start] = size;
+        holes_by_size.insert({size, start});
+    }
+
+    void remove_hole(unsigned int start, unsigned int size) {
+        holes.erase(start);
+        holes_by_size.erase({size, start});
+    }
+
+    bool assign_contiguous(unsigned int requested, int &partition_number) {
+        unsigned int size = std::max(requested, 1u);
+
+        auto it = holes_by_size.lower_bound({size, 0});
+        if (it == holes_by_size.end()) return false;
+
+        auto [hole_size, start] = *it;
+        remove_hole(start, hole_size);
+        if (hole_size > size) add_hole(start + size, hole_size - size);
+
+        allocated[start] = size;
+        counters.allocated += size;
+        partition_number = start;
+        return true;
+    }
+
+    void free_contiguous(unsigned int start) {
+        unsigned int size = allocated[start];
+        allocated.erase(start);
+        counters.allocated -= size;
+
+        // merge with the hole right after and right before the block
+        auto next = holes.find(start + size);
+        if (next != holes.end()) {
+            size += next->second;
+            remove_hole(next->first, next->second);
+        }
+
+        auto prev = holes.lower_bound(start);
+        if (prev != holes.begin()) {
+            --prev;
+            if (prev->first + prev->second == start) {
+                start = prev->first;
+                size += prev->second;
+                remove_hole(prev->first, prev->second);
+            }
+        }
+        add_hole(start, size);
+    }
+
+    memory_strategy                                     strategy;
+
+    partition_table                                     partitions;
+    std::set<std::pair<unsigned int, std::size_t>>      free_by_size;
+    std::vector<unsigned int>                           fit_tree;
+    std::size_t                                         leaves = 1;
+
+    std::vector<std::set<unsigned int>>                 buddy_free;     // per order
+    std::map<unsigned int, unsigned int>                holes;          // start -> size
+    std::set<std::pair<unsigned int, unsigned int>>     holes_by_size;  // (size, start)
+    std::map<unsigned int, unsigned int>                allocated;      // start -> order / size
+
+    std::unordered_map<int, unsigned int>               requested;      // partition_number -> KB asked for
+    memory_usage                                        counters;
+};
+
+//Convert the numeric input fields into a PCB
 // PROCESS CREATION (EXTENDED)
-inline PCB add_process(std::vector<std::string> tokens) {
+//   PID, size, arrival, CPU time, I/O frequency, I/O duration[, priority]
+inline PCB add_process(const int* fields, std::size_t count) {
     PCB process;
 
-    process.PID              = std::stoi(tokens[0]);
-    process.size             = std::stoi(tokens[1]);
-    process.arrival_time     = std::stoi(tokens[2]);
-    process.processing_time = std::stoi(tokens[3]);
-    process.remaining_time  = std::stoi(tokens[3]);
-    process.io_freq          = std::stoi(tokens[4]);
-    process.io_duration      = std::stoi(tokens[5]);
+    process.PID              = fields[0];
+    process.size             = fields[1];
+    process.arrival_time     = fields[2];
+    process.processing_time = fields[3];
+    process.remaining_time  = fields[3];
+    process.io_freq          = fields[4];
+    process.io_duration      = fields[5];
 
-    // Optional 7th field for priority (EP / EP+RR)
-    process.priority         = (tokens.size() > 6) ? std::stoi(tokens[6]) : 0;
+    // Optional 7th field for priority (EP / EP+RR), 8th and 9th for the
+    // I/O device and block
+    process.priority         = (count > 6) ? fields[6] : 0;
+    process.io_device        = (count > 7) ? fields[7] : -1;
+    process.io_block         = (count > 8) ? fields[8] : 0;
 
     process.start_time        = -1;
     process.partition_number = -1;
@@ -233,59 +826,2003 @@ inline PCB add_process(std::vector<std::string> tokens) {
     return process;
 }
 
-// QUEUE / CPU HELPERS
-inline void sync_queue(std::vector<PCB> &process_queue, PCB _process) {
-    for(auto &process : process_queue)
-        if(process.PID == _process.PID) process = _process;
+//Convert a list of strings into a PCB
+inline PCB add_process(std::vector<std::string> tokens) {
+    int fields[9];
+    std::size_t count = std::min<std::size_t>(tokens.size(), 9);
+
+    for (std::size_t i = 0; i < count; i++)
+        fields[i] = std::stoi(tokens[i]);
+
+    return add_process(fields, count);
 }
 
-//Returns true if all processes in the queue have terminated
-inline bool all_process_terminated(std::vector<PCB> processes) {
-    for(auto process : processes)
-        if(process.state != TERMINATED) return false;
-    return true;
+// INPUT LOADING
+//Parse one input line in place. Fields are comma separated and may be
+//padded with any amount of blanks ("4,  8, 40, ..."). Returns the number
+//of fields, 0 for a blank line and -1 for a malformed one, which includes
+//a negative size, arrival time, I/O field or block and a CPU time below 1.
+inline int parse_process_line(std::string_view line, int* fields) {
+    std::size_t count = 0;
+    std::size_t pos   = 0;
+
+    auto skip_blanks = [&]() {
+        while (pos < line.size() &&
+               (line[pos] == ' ' || line[pos] == '\t' || line[pos] == '\r'))
+            pos++;
+    };
+
+    skip_blanks();
+    if (pos == line.size()) return 0;
+
+    while (true) {
+        if (count == 9) return -1;
+
+        auto [end, error] = std::from_chars(line.data() + pos,
+                                            line.data() + line.size(),
+                                            fields[count]);
+        if (error != std::errc()) return -1;
+        pos = end - line.data();
+        count++;
+
+        skip_blanks();
+        if (pos == line.size()) break;
+        if (line[pos] != ',') return -1;
+        pos++;
+        skip_blanks();
+    }
+
+    if (count < 6) return -1;
+
+    // these end up in unsigned PCB fields
+    if (fields[1] < 0 || fields[2] < 0 || fields[3] <= 0 ||
+        fields[4] < 0 || fields[5] < 0 || (count > 8 && fields[8] < 0))
+        return -1;
+
+    return static_cast<int>(count);
+}
+
+//Load every process of an input file. The file is memory-mapped and the
+//fields are parsed straight out of the mapping, without copying lines.
+//What went wrong is written to errors.
+inline bool load_processes(const char* filename, std::vector<PCB> &processes,
+                           std::ostream &errors = std::cerr) {
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) {
+        errors << "Error opening file.\n";
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        close(fd);
+        errors << "Error opening file.\n";
+        return false;
+    }
+
+    std::size_t length = info.st_size;
+    const char* data   = nullptr;
+
+    if (length > 0) {
+        void* mapping = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping == MAP_FAILED) {
+            close(fd);
+            errors << "Error reading file.\n";
+            return false;
+        }
+        data = static_cast<const char*>(mapping);
+        madvise(mapping, length, MADV_SEQUENTIAL);
+    }
+    close(fd);
+
+    std::string_view input(data, length);
+    std::size_t line_number = 0;
+    bool ok = true;
+
+    while (!input.empty()) {
+        std::size_t end = input.find('\n');
+        std::string_view line = input.substr(0, end);
+        input.remove_prefix(end == std::string_view::npos ? input.size() : end + 1);
+        line_number++;
+
+        int fields[9];
+        int count = parse_process_line(line, fields);
+
+        if (count == 0) continue;
+        if (count < 0) {
+            errors << "Malformed input on line " << line_number << ".\n";
+            ok = false;
+            break;
+        }
+        processes.push_back(add_process(fields, count));
+    }
+
+    if (length > 0)
+        munmap(const_cast<char*>(data), length);
+    return ok;
 }
 
-//Terminates a given process
-inline void terminate_process(PCB &running, std::vector<PCB> &job_queue) {
-    running.remaining_time = 0;
-    running.state = TERMINATED;
-    free_memory(running);
-    sync_queue(job_queue, running);
+// ================================
+// PROCESS STORE
+// ================================
+// The process table of a run as a structure of arrays. The fields the main
+// loop reads or writes on every transition each have a dense array of
+// their own (hot); the rest of the PCB stays together in one record per
+// process (cold). Process i is entry i of every array. States change
+// through set_state, which keeps a live count of processes per state.
+// Feedback levels (MLFQ) carry the boost epoch they were set in, so a
+// priority boost is one increment instead of a pass over every process.
+
+//Cold part of a PCB
+struct process_record {
+    int             PID;
+    unsigned int    size;
+    unsigned int    arrival_time;
+    int             start_time;
+    unsigned int    processing_time;
+    int             partition_number;
+    unsigned int    io_freq;
+    unsigned int    io_duration;
+    int             io_device;
+    unsigned int    io_block;
+
+    //METRICS TRACKING
+    unsigned int    completion_time;
+    unsigned int    total_wait_time;
+    unsigned int    last_ready_time;
+};
+
+struct process_store {
+    process_store() {}
+
+    explicit process_store(const std::vector<PCB> &processes) {
+        for (const PCB &p : processes)
+            add(p);
+    }
+
+    std::size_t size() const { return info.size(); }
+
+    void add(const PCB &p) {
+        state.push_back(p.state);
+        in_state[p.state]++;
+        remaining_time.push_back(p.remaining_time);
+        remaining_io_time.push_back(p.remaining_io_time);
+        priority.push_back(p.priority);
+        level.push_back(0);
+        level_epoch.push_back(0);
+        info.push_back({p.PID, p.size, p.arrival_time, p.start_time,
+                        p.processing_time, p.partition_number, p.io_freq,
+                        p.io_duration, p.io_device, p.io_block,
+                        p.completion_time, p.total_wait_time,
+                        p.last_ready_time});
+    }
+
+    void set_state(std::size_t i, states s) {
+        in_state[state[i]]--;
+        in_state[s]++;
+        state[i] = s;
+    }
+
+    //Number of processes in state s, O(1)
+    std::size_t count(states s) const { return in_state[s]; }
+
+    //Feedback level of process i, 0 (top) if boosted since it was set
+    unsigned int level_of(std::size_t i) const {
+        return level_epoch[i] == boost_epoch ? level[i] : 0;
+    }
+
+    void set_level(std::size_t i, unsigned int l) {
+        level[i]       = l;
+        level_epoch[i] = boost_epoch;
+    }
+
+    //Every process back to level 0, O(1)
+    void boost() { boost_epoch++; }
+
+    //Process i as a PCB again
+    PCB pcb(std::size_t i) const {
+        const process_record &r = info[i];
+        PCB p;
+        p.PID               = r.PID;
+        p.size              = r.size;
+        p.arrival_time      = r.arrival_time;
+        p.start_time        = r.start_time;
+        p.processing_time   = r.processing_time;
+        p.remaining_time    = remaining_time[i];
+        p.partition_number  = r.partition_number;
+        p.state             = state[i];
+        p.io_freq           = r.io_freq;
+        p.io_duration       = r.io_duration;
+        p.remaining_io_time = remaining_io_time[i];
+        p.priority          = priority[i];
+        p.io_device         = r.io_device;
+        p.io_block          = r.io_block;
+        p.completion_time   = r.completion_time;
+        p.total_wait_time   = r.total_wait_time;
+        p.last_ready_time   = r.last_ready_time;
+        return p;
+    }
+
+    // hot
+    std::vector<states>         state;
+    std::vector<unsigned int>   remaining_time;
+    std::vector<unsigned int>   remaining_io_time;  // I/O deadline while WAITING
+    std::vector<int>            priority;
+    std::vector<unsigned char>  level;              // read through level_of
+    std::vector<unsigned int>   level_epoch;
+
+    // cold
+    std::vector<process_record> info;
+
+private:
+    std::size_t                 in_state[STATE_COUNT] = {};
+    unsigned int                boost_epoch = 0;
+};
+
+// QUEUE / CPU HELPERS
+// Every queue holds indices into one process store, so a state change is
+// made once, in place, on the store entry
+const int NO_PROCESS = -1;      // index of an idle CPU
+
+//Terminates process i
+inline void terminate_process(process_store &process_table, int i,
+                              memory_manager &memory) {
+    process_table.remaining_time[i] = 0;
+    process_table.set_state(i, TERMINATED);
+    memory.free_memory(process_table.info[i].PID,
+                       process_table.info[i].partition_number);
 }
 
-inline void idle_CPU(PCB &running) {
-    running.start_time = 0;
-    running.processing_time = 0;
-    running.remaining_time = 0;
-    running.arrival_time = 0;
-    running.io_duration = 0;
-    running.io_freq = 0;
-    running.partition_number = 0;
-    running.size = 0;
-    running.state = NOT_ASSIGNED;
-    running.PID = -1;
+// ARRIVALS
+//Indices into the process table sorted by arrival time (input order among
+//equal arrival times), the simulation consumes them through a cursor
+inline std::vector<int> arrival_order(const process_store &process_table) {
+    std::vector<int> order;
+    for (int i = 0; i < (int)process_table.size(); i++)
+        order.push_back(i);
+
+    std::stable_sort(order.begin(), order.end(),
+                     [&](int a, int b) {
+                         return process_table.info[a].arrival_time <
+                                process_table.info[b].arrival_time;
+                     });
+    return order;
 }
 
-inline std::string memory_status(unsigned int current_time,
-                                 const std::vector<PCB> &job_list) {
-    unsigned int used = 0;
+//Processes that arrived while no memory could hold them, oldest first.
+//Like fit_tree in the memory manager, a tree over the queue keeps the
+//smallest size per range, so the oldest process that fits in the largest
+//free block is found in O(log n) and a termination only retries what can
+//actually be admitted.
+class deferred_queue {
+public:
+    //capacity: processes ever deferred (each process is deferred once)
+    explicit deferred_queue(std::size_t capacity = 0) {
+        while (leaves < capacity) leaves *= 2;
+        min_size.assign(2 * leaves, NONE);
+        process.resize(leaves, NO_PROCESS);
+    }
+
+    void push(int i, unsigned int size) {
+        process[next] = i;
+        set_leaf(next++, size);
+        count++;
+    }
+
+    bool empty() const              { return count == 0; }
+    std::size_t size() const        { return count; }
+
+    //Slot of the oldest process of at most largest KB, -1 if there is none
+    long long find(unsigned int largest) const {
+        if (min_size[1] > largest) return -1;
+
+        std::size_t node = 1;
+        while (node < leaves)
+            node = (min_size[2 * node] <= largest) ? 2 * node : 2 * node + 1;
+        return node - leaves;
+    }
+
+    int operator[](std::size_t slot) const { return process[slot]; }
+
+    void erase(std::size_t slot) {
+        set_leaf(slot, NONE);
+        count--;
+    }
+
+private:
+    static constexpr unsigned long long NONE = ULLONG_MAX;  // empty slot
 
-    for (const auto &p : job_list) {
-        if (p.state != TERMINATED && p.partition_number != -1)
-            used += p.size;
+    void set_leaf(std::size_t slot, unsigned long long value) {
+        std::size_t node = slot + leaves;
+        min_size[node] = value;
+        for (node /= 2; node > 0; node /= 2)
+            min_size[node] = std::min(min_size[2 * node], min_size[2 * node + 1]);
     }
 
-    std::stringstream ss;
-    ss << "Time " << current_time
-       << " | Used Memory: " << used << " KB\n";
+    std::vector<unsigned long long> min_size;   // smallest size per range
+    std::vector<int>                process;    // per slot, in deferral order
+    std::size_t                     leaves = 1;
+    std::size_t                     next   = 0; // next free slot
+    std::size_t                     count  = 0;
+};
+
+//Number of CPU ms running process i can execute before its next
+//I/O request, termination or quantum expiry (quantum_left = 0: no quantum)
+inline unsigned int cpu_ticks_to_transition(const process_store &process_table,
+                                            int i, unsigned int quantum_left) {
+    const process_record &running = process_table.info[i];
+    unsigned int remaining = process_table.remaining_time[i];
+    unsigned int ticks = remaining;
+
+    if (running.io_freq > 0) {
+        unsigned int cpu_used = running.processing_time - remaining;
+        unsigned int to_io = running.io_freq - (cpu_used % running.io_freq);
+        if (to_io < ticks) ticks = to_io;
+    }
 
-    return ss.str();
+    if (quantum_left > 0 && quantum_left < ticks)
+        ticks = quantum_left;
+
+    return ticks;
 }
 
 // INTERRUPT / CONTEXT SWITCH OVERHEAD
-inline void simulate_interrupt_overhead(unsigned int &current_time) {
-    const unsigned int ISR_OVERHEAD = 5;   // mock ISR time
-    current_time += ISR_OVERHEAD;
+inline void simulate_interrupt_overhead(unsigned int &current_time,
+                                        unsigned int isr_overhead) {
+    current_time += isr_overhead;   // mock ISR time
+}
+
+// ================================
+// READY QUEUES
+// ================================
+// Both queues share push / top / pop / empty / size so a policy can pick
+// either one without touching the simulation loop.
+
+//Plain FIFO ready queue (RR)
+class fifo_ready_queue {
+public:
+    explicit fifo_ready_queue(const process_store &) {}
+
+    void push(int process)          { queue.push_back(process); }
+    int top() const                 { return queue.front(); }
+    bool empty() const              { return queue.empty(); }
+    std::size_t size() const        { return queue.size(); }
+
+    int pop() {
+        int process = queue.front();
+        queue.pop_front();
+        return process;
+    }
+
+private:
+    std::deque<int> queue;
+};
+
+//Ready queue kept as a binary heap: O(log n) push / pop, O(1) top.
+//Higher(table, a, b) is true when process a must run before process b;
+//processes that compare equal leave in the order they were pushed.
+template <typename Higher>
+class priority_ready_queue {
+public:
+    explicit priority_ready_queue(const process_store &process_table)
+        : process_table(process_table) {}
+
+    void push(int process) {
+        heap.push_back({process, next_seq++});
+        std::push_heap(heap.begin(), heap.end(), runs_later());
+    }
+
+    int top() const                 { return heap.front().process; }
+    bool empty() const              { return heap.empty(); }
+    std::size_t size() const        { return heap.size(); }
+
+    int pop() {
+        std::pop_heap(heap.begin(), heap.end(), runs_later());
+        int process = heap.back().process;
+        heap.pop_back();
+        return process;
+    }
+
+private:
+    struct entry {
+        int                 process;
+        unsigned long long  seq;        // push order, breaks ties FIFO
+    };
+
+    auto runs_later() const {
+        return [this](const entry &a, const entry &b) {
+            if (Higher()(process_table, b.process, a.process)) return true;
+            if (Higher()(process_table, a.process, b.process)) return false;
+            return a.seq > b.seq;
+        };
+    }
+
+    const process_store     &process_table;
+    std::vector<entry>      heap;
+    unsigned long long      next_seq = 0;
+};
+
+//Multi-level feedback ready queue: a FIFO per level and a bitmap of the
+//non-empty levels, so push / top / pop are O(1). Lower levels run first,
+//a process is queued on its level_of at push time.
+class mlfq_ready_queue {
+public:
+    static constexpr unsigned int max_levels = 64;
+
+    explicit mlfq_ready_queue(const process_store &process_table)
+        : process_table(process_table) {}
+
+    void push(int process) {
+        unsigned int l = process_table.level_of(process);
+        if (l >= levels.size()) levels.resize(l + 1);
+        levels[l].push_back(process);
+        nonempty |= 1ull << l;
+        count++;
+    }
+
+    int top() const                 { return levels[first()].front(); }
+    bool empty() const              { return count == 0; }
+    std::size_t size() const        { return count; }
+
+    int pop() {
+        unsigned int l = first();
+        int process = levels[l].front();
+        levels[l].pop_front();
+        if (levels[l].empty()) nonempty &= ~(1ull << l);
+        count--;
+        return process;
+    }
+
+    //Priority boost: every queued process moves to level 0, higher
+    //levels first, FIFO within a level
+    void boost() {
+        for (std::size_t l = 1; l < levels.size(); l++) {
+            levels[0].insert(levels[0].end(), levels[l].begin(), levels[l].end());
+            levels[l].clear();
+        }
+        nonempty = (count > 0) ? 1 : 0;
+    }
+
+private:
+    unsigned int first() const { return __builtin_ctzll(nonempty); }
+
+    const process_store     &process_table;
+    std::vector<std::deque<int>> levels;
+    unsigned long long      nonempty = 0;   // bit l: levels[l] not empty
+    std::size_t             count    = 0;
+};
+
+//EP: lower priority value runs first
+struct lower_priority_value_first {
+    bool operator()(const process_store &p, int a, int b) const {
+        return p.priority[a] < p.priority[b];
+    }
+};
+
+//EP_RR: higher priority value runs first
+struct higher_priority_value_first {
+    bool operator()(const process_store &p, int a, int b) const {
+        return p.priority[a] > p.priority[b];
+    }
+};
+
+//SJF / SRTF: least remaining CPU time runs first
+struct shortest_remaining_first {
+    bool operator()(const process_store &p, int a, int b) const {
+        return p.remaining_time[a] < p.remaining_time[b];
+    }
+};
+
+//Priority with aging: lower value runs first and a READY process gains one
+//priority step for every Interval ms it waits. priority * Interval + the
+//time it became READY orders the queue the same way at any later time, so
+//aging never touches the queued processes.
+template <unsigned int Interval>
+struct aged_priority_first {
+    bool operator()(const process_store &p, int a, int b) const {
+        return key(p, a) < key(p, b);
+    }
+
+    static long long key(const process_store &p, int i) {
+        return (long long)p.priority[i] * Interval + p.info[i].last_ready_time;
+    }
+};
+
+// ================================
+// WAIT QUEUE
+// ================================
+//Processes blocked on I/O in a min-heap keyed on their absolute I/O
+//deadline, so only the completions that are due get touched. Equal
+//deadlines complete in the order the processes started waiting.
+class io_wait_queue {
+public:
+    void push(int process, unsigned int deadline) {
+        heap.push_back({deadline, next_seq++, process});
+        std::push_heap(heap.begin(), heap.end(), completes_later);
+    }
+
+    //True if the earliest I/O completes at or before clock
+    bool due(unsigned int clock) const {
+        return !heap.empty() && heap.front().deadline <= clock;
+    }
+
+    unsigned int next_deadline() const  { return heap.front().deadline; }
+    bool empty() const                  { return heap.empty(); }
+    std::size_t size() const            { return heap.size(); }
+
+    int pop() {
+        std::pop_heap(heap.begin(), heap.end(), completes_later);
+        int process = heap.back().process;
+        heap.pop_back();
+        return process;
+    }
+
+private:
+    struct entry {
+        unsigned int        deadline;
+        unsigned long long  seq;
+        int                 process;
+    };
+
+    static bool completes_later(const entry &a, const entry &b) {
+        if (a.deadline != b.deadline) return a.deadline > b.deadline;
+        return a.seq > b.seq;
+    }
+
+    std::vector<entry>  heap;
+    unsigned long long  next_seq = 0;
+};
+
+// ================================
+// I/O DEVICES
+// ================================
+// Without devices every I/O is its own io_duration countdown. A process
+// whose input names a device (8th column, optional block number in the
+// 9th) instead needs one of that device's channels for io_duration ms;
+// when all channels are busy it waits in the device queue, in FIFO order
+// or elevator (SCAN) order over the block numbers.
+enum io_discipline { IO_FIFO, IO_ELEVATOR };
+
+struct io_device_spec {
+    std::string     name;
+    unsigned int    channels   = 1;     // 0 = unlimited
+    io_discipline   discipline = IO_FIFO;
+};
+
+//Parse "disk:2:elevator,net:4" (name:channels[:fifo|elevator], comma or
+//newline separated)
+inline bool parse_device_spec(const std::string &spec,
+                              std::vector<io_device_spec> &devices) {
+    std::vector<io_device_spec> parsed;
+    std::string text = spec;
+    std::replace(text.begin(), text.end(), ',', '\n');
+
+    std::stringstream lines(text);
+    std::string line;
+
+    while (std::getline(lines, line)) {
+        line = line.substr(0, line.find('#'));
+        line.erase(std::remove_if(line.begin(), line.end(), ::isspace),
+                   line.end());
+        if (line.empty()) continue;
+
+        std::vector<std::string> fields = split_delim(line, ":");
+        io_device_spec device;
+        if (fields.size() < 2 || fields.size() > 3 || fields[0].empty() ||
+            !parse_unsigned(fields[1], device.channels))
+            return false;
+
+        device.name = fields[0];
+
+        if (fields.size() == 3) {
+            if (fields[2] == "elevator")  device.discipline = IO_ELEVATOR;
+            else if (fields[2] != "fifo") return false;
+        }
+        parsed.push_back(device);
+    }
+
+    if (parsed.empty()) return false;
+    devices = parsed;
+    return true;
+}
+
+// Per-device numbers of one run
+struct device_metrics {
+    std::string         name;
+    unsigned int        requests    = 0;
+    unsigned int        queued      = 0;    // requests that found no free channel
+    unsigned int        max_queue   = 0;
+    unsigned long long  queue_delay = 0;    // ms spent in the device queue
+};
+
+//Channels and request queues of the configured devices. Only the queued
+//requests are stored here; requests in service are in the wait queue.
+class io_devices {
+public:
+    explicit io_devices(const std::vector<io_device_spec> &specs) {
+        for (const auto &spec : specs) {
+            device d;
+            d.spec              = spec;
+            d.counters.name     = spec.name;
+            devices.push_back(d);
+        }
+    }
+
+    //True if I/O on device goes through a device queue
+    bool contended(int device) const {
+        return device >= 0 && device < (int)devices.size();
+    }
+
+    //Takes a channel for process and returns true, or queues the request
+    //and returns false if every channel is busy
+    bool request(int device, int process, unsigned int block, unsigned int time) {
+        auto &d = devices[device];
+        d.counters.requests++;
+
+        if (d.spec.channels == 0 || d.busy < d.spec.channels) {
+            d.busy++;
+            return true;
+        }
+
+        d.queue.insert({d.spec.discipline == IO_ELEVATOR ? block : 0,
+                        next_seq++, process, time});
+        d.counters.queued++;
+        d.counters.max_queue = std::max<unsigned int>(d.counters.max_queue,
+                                                      d.queue.size());
+        return false;
+    }
+
+    //Frees the channel of a finished request at time and hands it to the
+    //next queued request, whose process is returned (NO_PROCESS if none)
+    int release(int device, unsigned int time) {
+        auto &d = devices[device];
+
+        if (d.queue.empty()) {
+            d.busy--;
+            return NO_PROCESS;
+        }
+
+        auto next = d.queue.begin();
+
+        if (d.spec.discipline == IO_ELEVATOR) {
+            // keep sweeping in the current direction, reverse at the end
+            queued_request head{d.head, 0, 0, 0};
+            if (d.upward) {
+                next = d.queue.lower_bound(head);
+                if (next == d.queue.end()) {
+                    d.upward = false;
+                    next = d.queue.lower_bound(
+                        {std::prev(d.queue.end())->block, 0, 0, 0});
+                }
+            } else {
+                next = d.queue.upper_bound({d.head, ULLONG_MAX, 0, 0});
+                if (next == d.queue.begin()) {
+                    d.upward = true;
+                } else {
+                    next = std::prev(next);
+                    // first request of that block, FIFO among equal blocks
+                    next = d.queue.lower_bound({next->block, 0, 0, 0});
+                }
+            }
+            d.head = next->block;
+        }
+
+        int process = next->process;
+        d.counters.queue_delay += time - std::min(time, next->since);
+        d.queue.erase(next);
+        return process;
+    }
+
+    std::vector<device_metrics> metrics() const {
+        std::vector<device_metrics> all;
+        for (const auto &d : devices)
+            all.push_back(d.counters);
+        return all;
+    }
+
+private:
+    struct queued_request {
+        unsigned int        block;      // 0 on FIFO devices
+        unsigned long long  seq;
+        int                 process;
+        unsigned int        since;      // time the request was queued
+
+        bool operator<(const queued_request &other) const {
+            if (block != other.block) return block < other.block;
+            return seq < other.seq;
+        }
+    };
+
+    struct device {
+        io_device_spec              spec;
+        unsigned int                busy   = 0;     // channels in use
+        std::set<queued_request>    queue;
+        unsigned int                head   = 0;     // elevator position
+        bool                        upward = true;  // elevator direction
+        device_metrics              counters;
+    };
+
+    std::vector<device>     devices;
+    unsigned long long      next_seq = 0;
+};
+
+// ================================
+// SCHEDULING POLICIES
+// ================================
+// A policy is a plain struct handed to run_simulation<Policy>, so it is
+// resolved at compile time and the main loop has no virtual calls.
+// Besides its ready queue type, each policy carries the timing
+// conventions its scheduler was written with so the logs stay the same:
+//   quantum               CPU ms before a RR preemption (0 = none)
+//   preemptive            check the ready queue against the running process
+//   interrupt_overhead    ISR ms added after every CPU transition (0 = none)
+//   stamp_at_tick_end     CPU transitions happen at the end of the executed ms
+//   io_counts_iterations  I/O durations count loop iterations, not ms
+//   feedback              MLFQ levels: demotion on quantum expiry, promotion
+//                         on I/O return, a boost every boost_interval ms
+
+//Round Robin, 100 ms quantum
+struct RR_policy {
+    static constexpr const char*  name                 = "RR";
+    static constexpr const char*  execution_file       = "execution_RR.txt";
+    static constexpr const char*  memory_file          = "memory_RR.txt";
+    static constexpr unsigned int quantum              = 100;
+    static constexpr bool         preemptive           = false;
+    static constexpr unsigned int interrupt_overhead   = 0;
+    static constexpr bool         stamp_at_tick_end    = true;
+    static constexpr bool         io_counts_iterations = false;
+    static constexpr bool         feedback             = false;
+
+    typedef fifo_ready_queue ready_queue;
+
+    static bool preempts(const process_store &, int, int) { return false; }
+};
+
+//External Priority, non-preemptive (lower value = higher priority)
+struct EP_policy {
+    static constexpr const char*  name                 = "EP";
+    static constexpr const char*  execution_file       = "execution.txt";
+    static constexpr const char*  memory_file          = nullptr;
+    static constexpr unsigned int quantum              = 0;
+    static constexpr bool         preemptive           = false;
+    static constexpr unsigned int interrupt_overhead   = 0;
+    static constexpr bool         stamp_at_tick_end    = true;
+    static constexpr bool         io_counts_iterations = false;
+    static constexpr bool         feedback             = false;
+
+    typedef priority_ready_queue<lower_priority_value_first> ready_queue;
+
+    static bool preempts(const process_store &, int, int) { return false; }
+};
+
+//External Priority + Round Robin (higher value = higher priority)
+struct EP_RR_policy {
+    static constexpr const char*  name                 = "EP + RR";
+    static constexpr const char*  execution_file       = "execution_EP_RR.txt";
+    static constexpr const char*  memory_file          = "memory_EP_RR.txt";
+    static constexpr unsigned int quantum              = 100;
+    static constexpr bool         preemptive           = true;
+    static constexpr unsigned int interrupt_overhead   = 5;
+    static constexpr bool         stamp_at_tick_end    = false;
+    static constexpr bool         io_counts_iterations = true;
+    static constexpr bool         feedback             = false;
+
+    typedef priority_ready_queue<higher_priority_value_first> ready_queue;
+
+    static bool preempts(const process_store &p, int candidate, int running) {
+        return higher_priority_value_first()(p, candidate, running);
+    }
+};
+
+//Multi-level feedback queue: processes start on level 0, drop a level when
+//they use up their quantum, rise a level when they come back from I/O and
+//all return to level 0 every boost_interval ms. Level l has a quantum of
+//quantum << l unless the per-level quanta are given. A process on a lower
+//level preempts the running one.
+struct MLFQ_policy {
+    static constexpr const char*  name                 = "MLFQ";
+    static constexpr const char*  execution_file       = "execution_MLFQ.txt";
+    static constexpr const char*  memory_file          = "memory_MLFQ.txt";
+    static constexpr unsigned int quantum              = 20;
+    static constexpr bool         preemptive           = true;
+    static constexpr unsigned int interrupt_overhead   = 0;
+    static constexpr bool         stamp_at_tick_end    = true;
+    static constexpr bool         io_counts_iterations = false;
+    static constexpr bool         feedback             = true;
+    static constexpr unsigned int levels               = 3;
+    static constexpr unsigned int boost_interval       = 1000;
+
+    typedef mlfq_ready_queue ready_queue;
+
+    static bool preempts(const process_store &p, int candidate, int running) {
+        return p.level_of(candidate) < p.level_of(running);
+    }
+};
+
+//Shortest Job First, non-preemptive (least remaining CPU time)
+struct SJF_policy {
+    static constexpr const char*  name                 = "SJF";
+    static constexpr const char*  execution_file       = "execution_SJF.txt";
+    static constexpr const char*  memory_file          = "memory_SJF.txt";
+    static constexpr unsigned int quantum              = 0;
+    static constexpr bool         preemptive           = false;
+    static constexpr unsigned int interrupt_overhead   = 0;
+    static constexpr bool         stamp_at_tick_end    = true;
+    static constexpr bool         io_counts_iterations = false;
+    static constexpr bool         feedback             = false;
+
+    typedef priority_ready_queue<shortest_remaining_first> ready_queue;
+
+    static bool preempts(const process_store &, int, int) { return false; }
+};
+
+//Shortest Remaining Time First: SJF that preempts the running process when
+//an arrival or an I/O return has less CPU time left
+struct SRTF_policy {
+    static constexpr const char*  name                 = "SRTF";
+    static constexpr const char*  execution_file       = "execution_SRTF.txt";
+    static constexpr const char*  memory_file          = "memory_SRTF.txt";
+    static constexpr unsigned int quantum              = 0;
+    static constexpr bool         preemptive           = true;
+    static constexpr unsigned int interrupt_overhead   = 0;
+    static constexpr bool         stamp_at_tick_end    = true;
+    static constexpr bool         io_counts_iterations = false;
+    static constexpr bool         feedback             = false;
+
+    typedef priority_ready_queue<shortest_remaining_first> ready_queue;
+
+    static bool preempts(const process_store &p, int candidate, int running) {
+        return shortest_remaining_first()(p, candidate, running);
+    }
+};
+
+//External Priority with aging, non-preemptive (lower value = higher
+//priority, one step gained per aging_interval ms spent READY)
+struct AGING_policy {
+    static constexpr const char*  name                 = "Priority + Aging";
+    static constexpr const char*  execution_file       = "execution_AGING.txt";
+    static constexpr const char*  memory_file          = "memory_AGING.txt";
+    static constexpr unsigned int quantum              = 0;
+    static constexpr bool         preemptive           = false;
+    static constexpr unsigned int interrupt_overhead   = 0;
+    static constexpr bool         stamp_at_tick_end    = true;
+    static constexpr bool         io_counts_iterations = false;
+    static constexpr bool         feedback             = false;
+    static constexpr unsigned int aging_interval       = 100;
+
+    typedef priority_ready_queue<aged_priority_first<aging_interval>> ready_queue;
+
+    static bool preempts(const process_store &, int, int) { return false; }
+};
+
+//Run time overrides of a policy's quantum and ISR overhead (parameter
+//sweeps), -1 keeps the policy's own value; the number of CPUs and the
+//I/O devices
+struct simulation_params {
+    int                         quantum       = -1;
+    int                         isr_overhead  = -1;
+    std::vector<unsigned int>   level_quanta;               // MLFQ, empty: quantum << level
+    int                         boost_interval = -1;        // MLFQ ms, 0 = never
+    unsigned int                cores         = 1;
+    std::vector<io_device_spec> devices;
+    log_sink                    *occupancy     = nullptr;  // per-state counts over time (CSV)
+    log_sink                    *memory_series = nullptr;  // memory counters over time (CSV)
+
+    template <typename Policy>
+    unsigned int quantum_of() const {
+        return quantum < 0 ? Policy::quantum : quantum;
+    }
+
+    template <typename Policy>
+    unsigned int isr_overhead_of() const {
+        return isr_overhead < 0 ? Policy::interrupt_overhead : isr_overhead;
+    }
+
+    //Quantum of each feedback level, a single level without feedback
+    template <typename Policy>
+    std::vector<unsigned int> level_quanta_of() const {
+        std::vector<unsigned int> quanta(1, quantum_of<Policy>());
+        if constexpr (Policy::feedback) {
+            if (!level_quanta.empty()) return level_quanta;
+            for (unsigned int l = 1; l < Policy::levels; l++)
+                quanta.push_back(quantum_of<Policy>() << l);
+        }
+        return quanta;
+    }
+
+    template <typename Policy>
+    unsigned int boost_interval_of() const {
+        if constexpr (Policy::feedback)
+            return boost_interval < 0 ? Policy::boost_interval : boost_interval;
+        return 0;
+    }
+};
+
+//Per-level quanta as given on the command line ("20,40,80"), at most
+//mlfq_ready_queue::max_levels levels
+inline bool parse_level_quanta(const std::string &spec,
+                               std::vector<unsigned int> &quanta) {
+    std::vector<unsigned int> parsed;
+    if (!parse_partition_spec(spec, parsed) ||
+        parsed.size() > mlfq_ready_queue::max_levels)
+        return false;
+    quanta = parsed;
+    return true;
+}
+
+//Calls run(Policy()) for the policy named on the command line ("rr",
+//"ep", "ep_rr", "mlfq", "sjf", "srtf" or "aging"), false if the name is
+//unknown
+template <typename Run>
+bool with_policy(const std::string &name, Run run) {
+    if (name == "rr")         run(RR_policy());
+    else if (name == "ep")    run(EP_policy());
+    else if (name == "ep_rr") run(EP_RR_policy());
+    else if (name == "mlfq")  run(MLFQ_policy());
+    else if (name == "sjf")   run(SJF_policy());
+    else if (name == "srtf")  run(SRTF_policy());
+    else if (name == "aging") run(AGING_policy());
+    else return false;
+    return true;
+}
+
+// ================================
+// INSTRUMENTATION
+// ================================
+// Build with -DSIM_INSTRUMENT=1 to count and time the phases of the
+// simulation loop. Otherwise every probe is an empty inline function and
+// compiles away.
+#ifndef SIM_INSTRUMENT
+#define SIM_INSTRUMENT 0
+#endif
+
+enum sim_phase {
+    PHASE_ARRIVALS, PHASE_IO, PHASE_PREEMPTION, PHASE_DISPATCH,
+    PHASE_EXECUTE, PHASE_ADVANCE, PHASE_LOGGING, PHASE_COUNT
+};
+
+enum sim_event {
+    EVENT_CONTEXT_SWITCHES, EVENT_PREEMPTIONS, EVENT_QUANTUM_EXPIRIES,
+    EVENT_MEMORY_REJECTIONS, EVENT_DEFERRED_ADMISSIONS, EVENT_IO_REQUESTS,
+    EVENT_STEALS, EVENT_COUNT
+};
+
+enum sim_peak { PEAK_READY, PEAK_WAITING, PEAK_DEFERRED, PEAK_COUNT };
+
+// What the probes collected during one run (all zero without SIM_INSTRUMENT)
+struct instrumentation_data {
+    unsigned long long  phase_ns[PHASE_COUNT]    = {};  // exclusive time
+    unsigned long long  phase_calls[PHASE_COUNT] = {};
+    unsigned long long  events[EVENT_COUNT]      = {};
+    std::size_t         peaks[PEAK_COUNT]        = {};
+};
+
+template <bool Enabled>
+class sim_probes {
+public:
+    //Times a phase until the returned object goes out of scope. A phase
+    //entered inside another one (logging) pauses the outer one, so the
+    //phase times add up to the time spent in the loop.
+    class timer {
+    public:
+        timer(sim_probes &probes, sim_phase phase)
+            : probes(probes), outer(probes.current) {
+            probes.switch_to(phase);
+            probes.collected.phase_calls[phase]++;
+        }
+        ~timer() { probes.switch_to(outer); }
+
+        timer(const timer &) = delete;
+        timer &operator=(const timer &) = delete;
+
+    private:
+        sim_probes  &probes;
+        int         outer;
+    };
+
+    timer phase(sim_phase phase)            { return timer(*this, phase); }
+    void count(sim_event event)             { collected.events[event]++; }
+    void peak(sim_peak peak, std::size_t n) {
+        if (n > collected.peaks[peak]) collected.peaks[peak] = n;
+    }
+
+    const instrumentation_data &data() const { return collected; }
+
+private:
+    void switch_to(int phase) {
+        auto now = std::chrono::steady_clock::now();
+        if (current != PHASE_COUNT)
+            collected.phase_ns[current] +=
+                std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    now - since).count();
+        current = phase;
+        since   = now;
+    }
+
+    instrumentation_data                    collected;
+    int                                     current = PHASE_COUNT;  // none
+    std::chrono::steady_clock::time_point   since;
+};
+
+template <>
+class sim_probes<false> {
+public:
+    struct timer {
+        ~timer() {}     // a scope guard, like the real one
+    };
+
+    timer phase(sim_phase)              { return timer(); }
+    void count(sim_event)               {}
+    void peak(sim_peak, std::size_t)    {}
+
+    instrumentation_data data() const   { return instrumentation_data(); }
+};
+
+//Summary of the probes as text, or as JSON
+inline std::string print_instrumentation(const instrumentation_data &data,
+                                         bool json) {
+    static const char* const phases[] = {
+        "arrivals", "io", "preemption", "dispatch", "execute", "advance",
+        "logging"
+    };
+    static const char* const events[] = {
+        "context_switches", "preemptions", "quantum_expiries",
+        "memory_rejections", "deferred_admissions", "io_requests", "steals"
+    };
+    static const char* const peaks[] = { "ready", "waiting", "deferred" };
+
+    unsigned long long total_ns = 0;
+    for (unsigned long long ns : data.phase_ns)
+        total_ns += ns;
+
+    std::stringstream out;
+
+    if (json) {
+        out << "{\n  \"phases\": {";
+        for (int p = 0; p < PHASE_COUNT; p++)
+            out << (p ? "," : "") << "\n    \"" << phases[p] << "\": {\"calls\": "
+                << data.phase_calls[p] << ", \"ns\": " << data.phase_ns[p] << "}";
+        out << "\n  },\n  \"events\": {";
+        for (int e = 0; e < EVENT_COUNT; e++)
+            out << (e ? "," : "") << "\n    \"" << events[e] << "\": "
+                << data.events[e];
+        out << "\n  },\n  \"peak_queue_lengths\": {";
+        for (int k = 0; k < PEAK_COUNT; k++)
+            out << (k ? "," : "") << "\n    \"" << peaks[k] << "\": "
+                << data.peaks[k];
+        out << "\n  }\n}\n";
+        return out.str();
+    }
+
+    out << "\n=== Instrumentation ===\n";
+    for (int p = 0; p < PHASE_COUNT; p++) {
+        double share = total_ns > 0 ? 100.0 * data.phase_ns[p] / total_ns : 0;
+        out << std::left << std::setw(12) << phases[p] << std::right
+            << std::setw(12) << data.phase_calls[p] << " calls"
+            << std::setw(14) << data.phase_ns[p] / 1000 << " us"
+            << std::setw(8) << std::fixed << std::setprecision(1) << share
+            << " %\n" << std::defaultfloat;
+    }
+    for (int e = 0; e < EVENT_COUNT; e++)
+        out << events[e] << ": " << data.events[e] << "\n";
+    for (int k = 0; k < PEAK_COUNT; k++)
+        out << "peak " << peaks[k] << " queue: " << data.peaks[k] << "\n";
+    return out.str();
+}
+
+// ================================
+// STREAMING METRICS
+// ================================
+// Quantiles of whole ms values with a relative error of at most 1% in
+// O(log(max value)) memory: values go to logarithmic buckets (the DDSketch
+// layout), small values get a bucket each. Two sketches merge by adding
+// their bucket counts.
+class quantile_sketch {
+public:
+    void add(unsigned long long value) {
+        count++;
+        sum     += value;
+        maximum  = std::max<double>(maximum, value);
+        minimum  = (count == 1) ? value : std::min<double>(minimum, value);
+
+        if (value == 0) {
+            zeros++;
+            return;
+        }
+        std::size_t bucket = std::ceil(std::log(value) / LOG_GAMMA);
+        if (bucket >= buckets.size()) buckets.resize(bucket + 1, 0);
+        buckets[bucket]++;
+    }
+
+    void merge(const quantile_sketch &other) {
+        if (other.count == 0) return;
+        minimum  = (count == 0) ? other.minimum : std::min(minimum, other.minimum);
+        maximum  = std::max(maximum, other.maximum);
+        count += other.count;
+        sum   += other.sum;
+        zeros += other.zeros;
+        if (other.buckets.size() > buckets.size())
+            buckets.resize(other.buckets.size(), 0);
+        for (std::size_t b = 0; b < other.buckets.size(); b++)
+            buckets[b] += other.buckets[b];
+    }
+
+    //Value at quantile q (0..1) by nearest rank, 0 if empty
+    double quantile(double q) const {
+        if (count == 0) return 0;
+
+        unsigned long long rank = std::ceil(q * count);
+        rank = std::max(rank, 1ull) - 1;
+        if (rank < zeros) return 0;
+
+        unsigned long long seen = zeros;
+        for (std::size_t b = 0; b < buckets.size(); b++) {
+            seen += buckets[b];
+            if (seen <= rank) continue;
+
+            // bucket b holds (gamma^(b-1), gamma^b]: a single whole value
+            // or the middle of the bucket
+            double low  = std::exp((double(b) - 1) * LOG_GAMMA);
+            double high = std::exp(b * LOG_GAMMA);
+            double value = (std::floor(high) - 1 <= low)
+                ? std::floor(high)
+                : 2 * high / (GAMMA + 1);
+            return std::max(minimum, std::min(maximum, value));
+        }
+        return maximum;
+    }
+
+    unsigned long long size() const { return count; }
+    double mean() const             { return count > 0 ? sum / count : 0; }
+    double max() const              { return maximum; }
+
+private:
+    static constexpr double ACCURACY  = 0.01;
+    static constexpr double GAMMA     = (1 + ACCURACY) / (1 - ACCURACY);
+    static inline const double LOG_GAMMA = std::log(GAMMA);
+
+    std::vector<unsigned long long> buckets;    // bucket b: (gamma^(b-1), gamma^b]
+    unsigned long long              zeros     = 0;
+    unsigned long long              count     = 0;
+    double                          sum       = 0;
+    double                          minimum   = 0;
+    double                          maximum   = 0;
+};
+
+// Mean, tail and max of one per-process time (ms)
+struct latency_summary {
+    double  mean = 0;
+    double  p50  = 0;
+    double  p95  = 0;
+    double  p99  = 0;
+    double  max  = 0;
+};
+
+inline latency_summary summarize(const quantile_sketch &sketch) {
+    latency_summary s;
+    s.mean = sketch.mean();
+    s.p50  = sketch.quantile(0.50);
+    s.p95  = sketch.quantile(0.95);
+    s.p99  = sketch.quantile(0.99);
+    s.max  = sketch.max();
+    return s;
+}
+
+//Per-process times, recorded when each process terminates so nothing has
+//to be kept for a pass over the finished processes
+class metrics_accumulator {
+public:
+    void record(const process_record &p) {
+        wait.add(p.total_wait_time);
+        turnaround.add(p.completion_time - p.arrival_time);
+        response.add(p.start_time >= 0 ? p.start_time - p.arrival_time : 0);
+        finish_time = std::max(finish_time, p.completion_time);
+    }
+
+    void merge(const metrics_accumulator &other) {
+        wait.merge(other.wait);
+        turnaround.merge(other.turnaround);
+        response.merge(other.response);
+        finish_time = std::max(finish_time, other.finish_time);
+    }
+
+    quantile_sketch wait, turnaround, response;
+    unsigned int    finish_time = 0;
+};
+
+// ================================
+// SIMULATION ENGINE
+// ================================
+// Per-core numbers of one run
+struct core_metrics {
+    unsigned int    busy_time   = 0;    // ms spent executing processes
+    unsigned int    dispatches  = 0;
+    unsigned int    steals      = 0;    // processes taken from another core
+};
+
+// Summary numbers of one run (over the admitted processes)
+struct simulation_metrics {
+    unsigned int                processes       = 0;
+    unsigned int                finish_time     = 0;
+    double                      throughput      = 0;    // processes/ms
+    double                      avg_wait        = 0;    // ms
+    double                      avg_turnaround  = 0;
+    double                      avg_response    = 0;
+    latency_summary             wait;               // ms, per process
+    latency_summary             turnaround;
+    latency_summary             response;
+    double                      cpu_utilization = 0;    // busy share of all cores
+    std::vector<core_metrics>   cores;
+    std::vector<device_metrics> devices;
+    instrumentation_data        probes;     // SIM_INSTRUMENT builds only
+};
+
+inline std::string print_metrics(const char* policy_name,
+                                 const simulation_metrics &m) {
+    std::stringstream metrics;
+    metrics << "\n=== " << policy_name << " Metrics ===\n";
+    metrics << "Throughput: " << m.throughput << " processes/ms\n";
+    metrics << "Average Waiting Time: " << m.avg_wait << " ms\n";
+    metrics << "Average Turnaround Time: " << m.avg_turnaround << " ms\n";
+    metrics << "Average Response Time: " << m.avg_response << " ms\n";
+
+    const std::pair<const char*, const latency_summary*> tails[] = {
+        {"Waiting Time",    &m.wait},
+        {"Turnaround Time", &m.turnaround},
+        {"Response Time",   &m.response}
+    };
+    for (const auto &tail : tails) {
+        metrics << tail.first << " p50/p95/p99/max: " << tail.second->p50
+                << " / " << tail.second->p95 << " / " << tail.second->p99
+                << " / " << tail.second->max << " ms\n";
+    }
+    metrics << "CPU Utilization: " << 100 * m.cpu_utilization << "%\n";
+
+    // per-core lines only on multi-core runs
+    if (m.cores.size() > 1) {
+        for (std::size_t c = 0; c < m.cores.size(); c++) {
+            const core_metrics &core = m.cores[c];
+            double utilization = (m.finish_time > 0)
+                ? 100.0 * core.busy_time / m.finish_time
+                : 0;
+            metrics << "Core " << c << ": busy " << core.busy_time
+                    << " ms (" << utilization << "%), "
+                    << core.dispatches << " dispatches, "
+                    << core.steals << " steals\n";
+        }
+    }
+
+    for (const device_metrics &device : m.devices) {
+        double delay = (device.requests > 0)
+            ? static_cast<double>(device.queue_delay) / device.requests
+            : 0;
+        metrics << "Device " << device.name << ": " << device.requests
+                << " requests, " << device.queued << " queued (max "
+                << device.max_queue << "), average queue delay "
+                << delay << " ms\n";
+    }
+    return metrics.str();
+}
+
+//Cores ranked on one number each (load, ready queue length). Like the
+//deferred queue, a tree over the cores keeps the best one per range, the
+//lowest index among equals, so the best core is read in O(1) and a
+//change costs O(log cores).
+template <typename Better>
+class core_ranking {
+public:
+    //unused: value of the padding leaves, never better than a real core
+    core_ranking(std::size_t cores, std::size_t unused) {
+        while (leaves < cores) leaves *= 2;
+        value.assign(leaves, unused);
+        std::fill(value.begin(), value.begin() + cores, 0);
+
+        best.resize(2 * leaves);
+        for (std::size_t c = 0; c < leaves; c++)
+            best[leaves + c] = c;
+        for (std::size_t node = leaves - 1; node > 0; node--)
+            best[node] = pick(best[2 * node], best[2 * node + 1]);
+    }
+
+    std::size_t top() const { return best[1]; }
+
+    void set(std::size_t core, std::size_t v) {
+        value[core] = v;
+        for (std::size_t node = (core + leaves) / 2; node > 0; node /= 2)
+            best[node] = pick(best[2 * node], best[2 * node + 1]);
+    }
+
+private:
+    std::size_t pick(std::size_t left, std::size_t right) const {
+        return Better()(value[right], value[left]) ? right : left;
+    }
+
+    std::vector<std::size_t>    value;      // per core
+    std::vector<std::size_t>    best;       // best core per range
+    std::size_t                 leaves = 1;
+};
+
+struct fewer_processes {
+    bool operator()(std::size_t a, std::size_t b) const { return a < b; }
+};
+
+struct more_processes {
+    bool operator()(std::size_t a, std::size_t b) const { return a > b; }
+};
+
+//One simulated CPU: its ready queue, running slot and counters. The cores
+//of a run are kept side by side in one vector. The counters of a busy core
+//(quantum_counter, busy_time and the remaining time of its process) lag
+//behind: they catch up with the CPU clock when the core is looked at, so
+//a ms of execution only touches the cores with a transition.
+template <typename ready_queue_type>
+struct cpu_core {
+    explicit cpu_core(const process_store &process_table)
+        : ready_queue(process_table) {}
+
+    ready_queue_type    ready_queue;
+    int                 running         = NO_PROCESS;
+    unsigned int        quantum         = 0;    // of the running process, 0 = none
+    unsigned int        quantum_counter = 0;
+    unsigned int        synced          = 0;    // CPU clock the counters are at
+    unsigned int        due             = 0;    // CPU clock of the next transition
+    core_metrics        counters;
+};
+
+//All the state of one simulation run: process table, memory, queues,
+//clock and output sinks. Nothing is shared between contexts, so any
+//number of them can run at the same time on different threads.
+//
+//With several cores, admitted processes go to the least loaded core and
+//come back to the core they last ran on after I/O or a preemption. A core
+//that idles with an empty ready queue steals the next process of the
+//core with the longest queue. The ISR overhead still stalls the whole
+//machine, as it does with one core. Idle cores, the transitions of the
+//busy ones and the core rankings are all kept in heaps or trees, so an
+//event costs O(log cores) however many cores there are.
+template <typename Policy>
+class simulation_context {
+public:
+    typedef cpu_core<typename Policy::ready_queue> core_type;
+
+    simulation_context(const std::vector<PCB> &workload, memory_manager memory,
+                       log_sink &execution_log, log_sink &memory_log,
+                       trace_sink *trace = nullptr,
+                       simulation_params params = simulation_params())
+        : process_table(workload),
+          memory(std::move(memory)),
+          home_core(process_table.size(), 0),
+          devices(params.devices),
+          arrivals(arrival_order(process_table)),
+          deferred(process_table.size()),
+          execution_log(execution_log),
+          memory_log(memory_log),
+          trace(trace),
+          occupancy_log(params.occupancy),
+          memory_series(params.memory_series),
+          level_quanta(params.level_quanta_of<Policy>()),
+          boost_interval(params.boost_interval_of<Policy>()),
+          isr_overhead(params.isr_overhead_of<Policy>()),
+          by_load(std::max(1u, params.cores), SIZE_MAX),
+          by_queue(std::max(1u, params.cores), 0) {
+
+        next_boost = boost_interval;
+
+        occupancy_counts[NOT_ASSIGNED] = process_table.size();
+        last_occupancy[NOT_ASSIGNED]   = process_table.size();
+
+        cores.reserve(std::max(1u, params.cores));
+        for (unsigned int c = 0; c < std::max(1u, params.cores); c++) {
+            cores.emplace_back(process_table);
+            idle_cores.push_back(c);    // ascending: already a min-heap
+        }
+    }
+
+    //Runs the simulation to the end, writing the execution table and the
+    //memory log to the sinks (and every transition to trace) as it goes
+    simulation_metrics run() {
+
+        execution_log.write(print_exec_header());
+        if (occupancy_log != nullptr)
+            occupancy_log->write("time,new,ready,running,waiting,terminated\n");
+        if (memory_series != nullptr)
+            memory_series->write("time,used,free,allocated,largest_free,"
+                                 "internal_fragmentation,resident,rejections\n");
+
+        // main simulation loop
+        while (next_arrival < arrivals.size() ||
+               !deferred.empty() ||
+               process_table.count(READY) > 0 ||
+               process_table.count(RUNNING) > 0 ||
+               process_table.count(WAITING) > 0) {
+
+            admit_arrivals();
+            complete_io();
+            boost_levels();
+            check_preemption();
+            dispatch();
+            execute();
+
+            if (!advance()) break;
+        }
+
+        log_occupancy();
+        execution_log.write(print_exec_footer());
+
+        simulation_metrics metrics = compute_metrics();
+        execution_log.write(print_metrics(Policy::name, metrics));
+        return metrics;
+    }
+
+    //Final state of process i
+    PCB process(std::size_t i) const { return process_table.pcb(i); }
+
+private:
+    // clock the I/O deadlines are measured on
+    unsigned int io_clock() const {
+        return Policy::io_counts_iterations ? iteration : current_time;
+    }
+
+    // one state transition: execution table row and binary trace record
+    void log_transition(unsigned int time, int PID,
+                        states old_state, states new_state) {
+        auto timer = probes.phase(PHASE_LOGGING);
+        execution_log.exec_status(time, PID, old_state, new_state);
+        if (trace != nullptr)
+            trace->record(time, PID, old_state, new_state);
+        track_occupancy(time, old_state, new_state);
+    }
+
+    // memory log row (and memory series row)
+    void log_memory(unsigned int time) {
+        auto timer = probes.phase(PHASE_LOGGING);
+        memory_log.memory_status(time, memory.usage().used);
+        if (memory_series != nullptr)
+            memory_series->memory_usage_row(time, memory.usage());
+    }
+
+    // occupancy counts follow the logged transitions, so each row carries
+    // the stamp of the execution table rows it sums up
+    void track_occupancy(unsigned int time, states old_state, states new_state) {
+        if (occupancy_log == nullptr) return;
+        if (time != occupancy_time) log_occupancy();
+        occupancy_counts[old_state]--;
+        occupancy_counts[new_state]++;
+        occupancy_time = time;
+    }
+
+    // state occupancy row for occupancy_time, only when a count changed
+    // since the last one
+    void log_occupancy() {
+        if (occupancy_log == nullptr) return;
+        if (std::equal(occupancy_counts, occupancy_counts + STATE_COUNT,
+                       last_occupancy)) return;
+
+        occupancy_log->occupancy(occupancy_time, occupancy_counts);
+        std::copy(occupancy_counts, occupancy_counts + STATE_COUNT, last_occupancy);
+    }
+
+    // READY process i joins the ready queue of core c
+    void make_ready(int i, std::size_t c, unsigned int time) {
+        process_table.set_state(i, READY);
+        process_table.info[i].last_ready_time = time;
+
+        home_core[i] = c;
+        cores[c].ready_queue.push(i);
+        rank_core(c);
+        probes.peak(PEAK_READY, process_table.count(READY));
+
+        // only a new arrival in the queue can preempt the running process
+        if (Policy::preemptive &&
+            cores[c].running != NO_PROCESS && cores[c].running != i)
+            preemption_checks.push_back(c);
+    }
+
+    // core c goes idle after a transition of its running process
+    void release_cpu(std::size_t c) {
+        cores[c].running         = NO_PROCESS;
+        cores[c].quantum_counter = 0;
+        rank_core(c);
+
+        idle_cores.push_back(c);
+        std::push_heap(idle_cores.begin(), idle_cores.end(), higher_index);
+
+        if (isr_overhead > 0)
+            simulate_interrupt_overhead(current_time, isr_overhead);
+    }
+
+    static bool higher_index(std::size_t a, std::size_t b) { return a > b; }
+
+    // core c's ready queue or running slot changed
+    void rank_core(std::size_t c) {
+        std::size_t queued = cores[c].ready_queue.size();
+        by_load.set(c, queued + (cores[c].running != NO_PROCESS ? 1 : 0));
+        by_queue.set(c, queued);
+    }
+
+    // core with the fewest READY and RUNNING processes (lowest index first)
+    std::size_t least_loaded_core() const { return by_load.top(); }
+
+    // brings the lagging counters of busy core c up to the CPU clock
+    void sync_core(core_type &core) {
+        unsigned int ran = cpu_clock - core.synced;
+        process_table.remaining_time[core.running] -= ran;
+        core.quantum_counter    += ran;
+        core.counters.busy_time += ran;
+        core.synced              = cpu_clock;
+    }
+
+    // CPU clock of the earliest pending transition, dropping the ones of
+    // preempted processes; false if no core is busy
+    bool next_transition(unsigned int &due) {
+        while (!transitions.empty()) {
+            const core_type &core = cores[transitions.front().second];
+            if (core.running != NO_PROCESS && core.due == transitions.front().first) {
+                due = core.due;
+                return true;
+            }
+            std::pop_heap(transitions.begin(), transitions.end(), transition_later);
+            transitions.pop_back();
+        }
+        return false;
+    }
+
+    static bool transition_later(const std::pair<unsigned int, std::size_t> &a,
+                                 const std::pair<unsigned int, std::size_t> &b) {
+        return a > b;
+    }
+
+    // NEW -> READY if a memory partition is free
+    bool admit(int i) {
+        process_record &process = process_table.info[i];
+
+        if (!memory.assign_memory(process.PID, process.size,
+                                  process.partition_number))
+            return false;
+
+        make_ready(i, least_loaded_core(), current_time);
+
+        log_transition(current_time, process.PID, NEW, READY);
+
+        // log memory state when a process is admitted
+        log_memory(current_time);
+        return true;
+    }
+
+    // 1) Process arrivals (NEW -> READY when memory available).
+    //    Processes that did not fit are retried, oldest first, once a
+    //    partition has been freed, but only those the memory manager can
+    //    place: the oldest one no larger than the largest free block fits
+    //    unless nothing is free at all. A process is rejected once, when
+    //    it is deferred.
+    void admit_arrivals() {
+        auto timer = probes.phase(PHASE_ARRIVALS);
+
+        if (memory_freed) {
+            long long slot;
+            while ((slot = deferred.find(memory.usage().largest_free)) >= 0 &&
+                   memory.fits(process_table.info[deferred[slot]].size)) {
+                admit(deferred[slot]);
+                deferred.erase(slot);
+                probes.count(EVENT_DEFERRED_ADMISSIONS);
+            }
+            memory_freed = false;
+        }
+
+        while (next_arrival < arrivals.size() &&
+               process_table.info[arrivals[next_arrival]].arrival_time <= current_time) {
+            int i = arrivals[next_arrival++];
+            process_table.set_state(i, NEW);
+            track_occupancy(current_time, NOT_ASSIGNED, NEW);
+            if (!admit(i)) {
+                deferred.push(i, process_table.info[i].size);
+                probes.count(EVENT_MEMORY_REJECTIONS);
+            }
+        }
+        probes.peak(PEAK_DEFERRED, deferred.size());
+    }
+
+    // I/O request of process i, issued at start on the I/O clock
+    void start_io(int i, unsigned int start) {
+        const process_record &process = process_table.info[i];
+        probes.count(EVENT_IO_REQUESTS);
+
+        if (devices.contended(process.io_device) &&
+            !devices.request(process.io_device, i, process.io_block, start))
+            return;     // queued until a channel frees up
+
+        process_table.remaining_io_time[i] = start + process.io_duration;
+        wait_queue.push(i, process_table.remaining_io_time[i]);
+        probes.peak(PEAK_WAITING, wait_queue.size());
+    }
+
+    // 2) Manage the wait queue (I/O completion: WAITING -> READY)
+    void complete_io() {
+        auto timer = probes.phase(PHASE_IO);
+
+        while (wait_queue.due(io_clock())) {
+
+            int i = wait_queue.pop();
+            int device = process_table.info[i].io_device;
+
+            // the channel goes to the next queued request of the device
+            if (devices.contended(device)) {
+                unsigned int done = process_table.remaining_io_time[i];
+                int next = devices.release(device, done);
+                if (next != NO_PROCESS) {
+                    process_table.remaining_io_time[next] =
+                        done + process_table.info[next].io_duration;
+                    wait_queue.push(next, process_table.remaining_io_time[next]);
+                }
+            }
+
+            // MLFQ: back from I/O, one level up
+            if (Policy::feedback && process_table.level_of(i) > 0)
+                process_table.set_level(i, process_table.level_of(i) - 1);
+
+            make_ready(i, home_core[i], current_time);
+
+            log_transition(current_time, process_table.info[i].PID, WAITING, READY);
+        }
+    }
+
+    // MLFQ: every boost_interval ms all the processes go back to level 0
+    void boost_levels() {
+        if (boost_interval == 0 || current_time < next_boost)
+            return;
+
+        process_table.boost();
+        if constexpr (Policy::feedback)
+            for (core_type &core : cores)
+                core.ready_queue.boost();
+
+        next_boost = (current_time / boost_interval + 1) * boost_interval;
+    }
+
+    // 3) Preemption by a higher priority READY process of the same core.
+    //    Only the cores that queued a process under a running one since
+    //    the last check can preempt: a dispatch takes the best process of
+    //    the queue and a running process never gets worse.
+    void check_preemption() {
+        if (!Policy::preemptive || preemption_checks.empty())
+            return;
+
+        auto timer = probes.phase(PHASE_PREEMPTION);
+
+        std::sort(preemption_checks.begin(), preemption_checks.end());
+        preemption_checks.erase(std::unique(preemption_checks.begin(),
+                                            preemption_checks.end()),
+                                preemption_checks.end());
+
+        for (std::size_t c : preemption_checks) {
+            core_type &core = cores[c];
+
+            if (core.running == NO_PROCESS || core.ready_queue.empty())
+                continue;
+
+            const process_record &cpu = process_table.info[core.running];
+            sync_core(core);
+
+            if (!Policy::preempts(process_table, core.ready_queue.top(),
+                                  core.running))
+                continue;
+
+            make_ready(core.running, c, current_time);
+            probes.count(EVENT_PREEMPTIONS);
+
+            log_transition(current_time, cpu.PID, RUNNING, READY);
+            release_cpu(c);
+        }
+        preemption_checks.clear();
+    }
+
+    // next READY process of the core with the longest ready queue
+    int steal() {
+        std::size_t victim = by_queue.top();
+        int process = cores[victim].ready_queue.pop();
+        rank_core(victim);
+        return process;
+    }
+
+    // 4) Dispatch: every idle core, lowest index first, takes its next
+    //    READY process, or steals one if its own queue is empty
+    void dispatch() {
+        auto timer = probes.phase(PHASE_DISPATCH);
+
+        while (!idle_cores.empty() && process_table.count(READY) > 0) {
+            std::pop_heap(idle_cores.begin(), idle_cores.end(), higher_index);
+            std::size_t c = idle_cores.back();
+            idle_cores.pop_back();
+            core_type &core = cores[c];
+
+            if (!core.ready_queue.empty()) {
+                core.running = core.ready_queue.pop();
+            } else {
+                core.running = steal();
+                core.counters.steals++;
+                probes.count(EVENT_STEALS);
+                home_core[core.running] = c;
+            }
+
+            process_record &cpu = process_table.info[core.running];
+
+            // accumulate wait time
+            cpu.total_wait_time += (current_time - cpu.last_ready_time);
+
+            process_table.set_state(core.running, RUNNING);
+
+            if (cpu.start_time == -1)
+                cpu.start_time = current_time;
+
+            core.quantum         = level_quanta[process_table.level_of(core.running)];
+            core.quantum_counter = 0;
+            core.counters.dispatches++;
+            probes.count(EVENT_CONTEXT_SWITCHES);
+            rank_core(c);
+
+            core.synced = cpu_clock;
+            core.due    = cpu_clock + cpu_ticks_to_transition(process_table,
+                                                              core.running,
+                                                              core.quantum);
+            transitions.push_back({core.due, c});
+            std::push_heap(transitions.begin(), transitions.end(), transition_later);
+
+            log_transition(current_time, cpu.PID, READY, RUNNING);
+
+            if (isr_overhead > 0)
+                simulate_interrupt_overhead(current_time, isr_overhead);
+        }
+    }
+
+    // 5) CPU execution (1 ms on every busy core), only the cores with a
+    //    transition on this ms are touched
+    void execute() {
+        if (process_table.count(RUNNING) == 0)
+            return;
+
+        auto timer = probes.phase(PHASE_EXECUTE);
+
+        // the cores execute the same ms, ISR overheads only delay later ones
+        unsigned int now = current_time;
+
+        // time the CPU transitions below are logged at
+        unsigned int stamp = now + (Policy::stamp_at_tick_end ? 1 : 0);
+
+        cpu_clock++;
+
+        unsigned int due;
+        while (next_transition(due) && due == cpu_clock) {
+            std::size_t c = transitions.front().second;
+            std::pop_heap(transitions.begin(), transitions.end(), transition_later);
+            transitions.pop_back();
+
+            core_type &core = cores[c];
+            sync_core(core);
+
+            int running = core.running;
+            process_record &cpu = process_table.info[running];
+            unsigned int &remaining_time = process_table.remaining_time[running];
+
+            unsigned int cpu_used = cpu.processing_time - remaining_time;
+
+            // 5a) I/O interrupt
+            if (cpu.io_freq > 0 &&
+                cpu_used > 0 &&
+                (cpu_used % cpu.io_freq == 0) &&
+                remaining_time > 0) {
+
+                process_table.set_state(running, WAITING);
+                start_io(running,
+                         Policy::io_counts_iterations ? iteration : stamp);
+
+                log_transition(stamp, cpu.PID, RUNNING, WAITING);
+                release_cpu(c);
+            }
+
+            // 5b) Process termination
+            else if (remaining_time == 0) {
+
+                cpu.completion_time = now + 1;
+
+                log_transition(stamp, cpu.PID, RUNNING, TERMINATED);
+
+                terminate_process(process_table, running, memory);
+                memory_freed = true;
+                finished.record(cpu);
+
+                // log memory after termination
+                log_memory(stamp);
+                release_cpu(c);
+            }
+
+            // 5c) Round Robin quantum expiry (MLFQ: one level down)
+            else if (core.quantum > 0 && core.quantum_counter == core.quantum) {
+
+                if (Policy::feedback)
+                    process_table.set_level(running,
+                        std::min<std::size_t>(process_table.level_of(running) + 1,
+                                              level_quanta.size() - 1));
+
+                make_ready(core.running, c, stamp);
+                probes.count(EVENT_QUANTUM_EXPIRIES);
+
+                log_transition(stamp, cpu.PID, RUNNING, READY);
+                release_cpu(c);
+            }
+        }
+    }
+
+    // 6) Advance to the next event. If a core is idle with READY
+    //    processes, or a freed partition may admit a deferred process,
+    //    that happens on the next ms. Otherwise nothing can happen before
+    //    the next arrival, I/O completion or the next transition of a
+    //    running process. Returns false when nothing can ever happen again.
+    bool advance() {
+        auto timer = probes.phase(PHASE_ADVANCE);
+
+        unsigned int next_time = current_time + 1;
+
+        std::size_t running_count = process_table.count(RUNNING);
+        bool idle_core = running_count < cores.size();
+
+        if (!(idle_core && process_table.count(READY) > 0) &&
+            !(memory_freed && !deferred.empty())) {
+
+            next_time = UINT_MAX;
+
+            // arrivals skipped over by the ISR overhead are admitted late
+            if (next_arrival < arrivals.size())
+                next_time = std::max(current_time + 1,
+                    process_table.info[arrivals[next_arrival]].arrival_time);
+
+            if (!wait_queue.empty()) {
+                unsigned int deadline = wait_queue.next_deadline();
+                unsigned int clock    = io_clock();
+                next_time = std::min(next_time, current_time +
+                    (deadline > clock ? deadline - clock : 1));
+            }
+
+            unsigned int due;
+            if (running_count > 0 && next_transition(due))
+                next_time = std::min(next_time, current_time + (due - cpu_clock));
+
+            if (next_time == UINT_MAX) return false;
+
+            if (boost_interval > 0)
+                next_time = std::min(next_time, std::max(current_time + 1, next_boost));
+
+            // the skipped ms are plain CPU execution
+            cpu_clock += next_time - current_time - 1;
+        }
+
+        iteration   += next_time - current_time;
+        current_time = next_time;
+        return true;
+    }
+
+    // 7) METRICS CALCULATION
+    simulation_metrics compute_metrics() const {
+        simulation_metrics m;
+        m.processes   = finished.wait.size();
+        m.finish_time = finished.finish_time;
+
+        m.wait           = summarize(finished.wait);
+        m.turnaround     = summarize(finished.turnaround);
+        m.response       = summarize(finished.response);
+        m.avg_wait       = m.wait.mean;
+        m.avg_turnaround = m.turnaround.mean;
+        m.avg_response   = m.response.mean;
+        m.throughput     = (m.finish_time > 0)
+                               ? static_cast<double>(m.processes) / m.finish_time
+                               : 0;
+
+        unsigned long long busy = 0;
+        for (const core_type &core : cores)
+            busy += core.counters.busy_time;
+        if (m.finish_time > 0)
+            m.cpu_utilization =
+                static_cast<double>(busy) / m.finish_time / cores.size();
+
+        for (const core_type &core : cores)
+            m.cores.push_back(core.counters);
+        m.devices = devices.metrics();
+        m.probes  = probes.data();
+        return m;
+    }
+
+    process_store                   process_table;
+    memory_manager                  memory;
+
+    std::vector<core_type>          cores;
+    std::vector<std::size_t>        home_core;      // core each process last queued on
+    io_wait_queue                   wait_queue;     // remaining_io_time = I/O deadline
+    io_devices                      devices;
+    sim_probes<SIM_INSTRUMENT>      probes;
+    metrics_accumulator             finished;       // times of terminated processes
+    std::vector<int>                arrivals;       // process table in arrival order
+    std::size_t                     next_arrival = 0;   // cursor into arrivals
+    deferred_queue                  deferred;       // arrived, no partition was free
+    bool                            memory_freed = false;
+
+    unsigned int                    current_time    = 0;
+    unsigned int                    iteration       = 0;    // loop iterations, skipped ones included
+
+    log_sink                        &execution_log;
+    log_sink                        &memory_log;
+    trace_sink                      *trace;
+    log_sink                        *occupancy_log;
+    log_sink                        *memory_series;
+    std::size_t                     occupancy_counts[STATE_COUNT] = {};
+    std::size_t                     last_occupancy[STATE_COUNT] = {};
+    unsigned int                    occupancy_time  = 0;
+
+    const std::vector<unsigned int> level_quanta;   // quantum per feedback level, 0 = no quantum
+    const unsigned int              boost_interval; // 0 = no boost
+    unsigned int                    next_boost;
+    const unsigned int              isr_overhead;   // 0 = no ISR overhead
+
+    unsigned int                    cpu_clock       = 0;    // ms executed by a busy core
+    std::vector<std::size_t>        idle_cores;             // min-heap of core indices
+    std::vector<std::pair<unsigned int, std::size_t>> transitions;  // min-heap of (due, core)
+    std::vector<std::size_t>        preemption_checks;      // cores to check for preemption
+    core_ranking<fewer_processes>   by_load;                // READY + RUNNING per core
+    core_ranking<more_processes>    by_queue;               // READY per core
+};
+
+//Runs one simulation with the given sinks (see simulation_context)
+template <typename Policy>
+simulation_metrics run_simulation(const std::vector<PCB> &workload,
+                                  memory_manager memory,
+                                  log_sink &execution_log, log_sink &memory_log,
+                                  trace_sink *trace = nullptr,
+                                  simulation_params params = simulation_params()) {
+    simulation_context<Policy> context(workload, std::move(memory),
+                                       execution_log, memory_log, trace, params);
+    return context.run();
+}
+
+// ================================
+// LIBRARY INTERFACE
+// ================================
+// Everything a run needs besides the workload
+struct simulation_config {
+    std::string                 policy          = "rr";     // rr | ep | ep_rr | mlfq | sjf | srtf | aging
+    memory_strategy             memory          = BEST_FIT;
+    std::vector<unsigned int>   partition_sizes = default_partition_sizes();
+    simulation_params           params;                     // quantum / ISR overrides
+    bool                        capture_logs    = false;    // keep the logs in the result
+};
+
+struct simulation_result {
+    bool                ok = false;     // false for an unknown policy
+    simulation_metrics  metrics;
+    std::string         execution;      // execution table (capture_logs only)
+    std::string         memory_log;     // memory log (capture_logs only)
+};
+
+//Runs one simulation of workload, re-entrant: it only touches its own
+//simulation_context
+inline simulation_result run_simulation(const simulation_config &config,
+                                        const std::vector<PCB> &workload) {
+    simulation_result result;
+
+    log_sink execution_log, memory_log;
+    if (config.capture_logs) {
+        execution_log.capture(result.execution);
+        memory_log.capture(result.memory_log);
+    }
+
+    memory_manager memory(config.partition_sizes, config.memory);
+
+    result.ok = with_policy(config.policy, [&](auto p) {
+        typedef decltype(p) Policy;
+        result.metrics = run_simulation<Policy>(workload, memory,
+                                                execution_log, memory_log,
+                                                nullptr, config.params);
+    });
+
+    execution_log.flush();
+    memory_log.flush();
+    return result;
 }
-#endif
\ No newline at end of file
+#endif
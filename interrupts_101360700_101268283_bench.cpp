@@ -0,0 +1,373 @@
+/**
+ * @file bench.cpp
+ * @author Nawal Musameh, Shahd Elsaman
+ * Microbenchmarks of the simulator hot paths: memory placement, the ready
+ * queues, execution log rows, input parsing and whole simulations of
+ * synthetic workloads (10 processes up to --max-processes, 1000000 by
+ * default). Each benchmark is repeated until it has run for --min-time
+ * seconds and the results are printed as JSON, in the layout of Google
+ * Benchmark's JSON output:
+ *   ./bench [--filter=substring] [--max-processes=1000000]
+ *           [--min-time=0.5] [--out=results.json]
+ */
+
+#include "interrupts_101360700_101268283.hpp"
+#include<chrono>
+#include<ctime>
+#include<thread>
+
+// TIMING
+struct bench_result {
+    std::string         name;
+    unsigned long long  iterations;
+    double              real_time;          // ns per iteration
+    double              cpu_time;           // ns per iteration
+    double              items_per_second;   // 0 if the benchmark has no items
+};
+
+//Keeps value alive so the measured work is not optimized away
+template <typename T>
+void do_not_optimize(const T &value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+//Runs body(iterations) with a growing iteration count until one batch
+//takes min_time seconds. body returns the number of items it processed.
+template <typename Body>
+bench_result measure(const std::string &name, double min_time, Body body) {
+    unsigned long long iterations = 1;
+
+    while (true) {
+        auto real_start = std::chrono::steady_clock::now();
+        std::clock_t cpu_start = std::clock();
+
+        unsigned long long items = body(iterations);
+
+        double real = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - real_start).count();
+        double cpu = double(std::clock() - cpu_start) / CLOCKS_PER_SEC;
+
+        if (real >= min_time || iterations >= (1ull << 40)) {
+            bench_result result;
+            result.name             = name;
+            result.iterations       = iterations;
+            result.real_time        = real * 1e9 / iterations;
+            result.cpu_time         = cpu * 1e9 / iterations;
+            result.items_per_second = (items > 0 && real > 0) ? items / real : 0;
+
+            // progress on stderr, the JSON goes to stdout
+            std::cerr << std::left << std::setw(52) << name << std::right
+                      << std::setw(14) << result.real_time << " ns "
+                      << std::setw(12) << iterations << "\n";
+            return result;
+        }
+
+        // aim a bit past min_time, as Google Benchmark does
+        double scale = (real > 0) ? 1.4 * min_time / real : 10;
+        iterations = std::max(iterations + 1,
+            (unsigned long long)(iterations * std::min(scale, 10.0)));
+    }
+}
+
+// SYNTHETIC WORKLOADS
+//n processes that fit the default partitions, arriving often enough to
+//keep the CPU busy without an ever growing backlog
+std::vector<PCB> synthetic_workload(std::size_t n, unsigned int seed = 42) {
+    std::mt19937 random(seed);
+    auto uniform = [&](int low, int high) {
+        return std::uniform_int_distribution<int>(low, high)(random);
+    };
+
+    std::vector<PCB> processes;
+    processes.reserve(n);
+
+    unsigned int arrival = 0;
+    for (std::size_t i = 0; i < n; i++) {
+        arrival += uniform(0, 400);
+        bool io = uniform(0, 1) == 1;
+        int fields[7] = {
+            (int)i + 1, uniform(1, 40), (int)arrival, uniform(10, 300),
+            io ? uniform(20, 100) : 0, io ? uniform(5, 50) : 0, uniform(0, 9)
+        };
+        processes.push_back(add_process(fields, 7));
+    }
+    return processes;
+}
+
+// BENCHMARKS
+struct bench_options {
+    std::string     filter;
+    std::size_t     max_processes = 1000000;
+    double          min_time      = 0.5;
+};
+
+void bench_memory(const bench_options &options, std::vector<bench_result> &results) {
+    const std::pair<const char*, memory_strategy> strategies[] = {
+        {"first_fit",  FIRST_FIT},
+        {"best_fit",   BEST_FIT},
+        {"worst_fit",  WORST_FIT},
+        {"buddy",      BUDDY},
+        {"contiguous", CONTIGUOUS}
+    };
+
+    std::vector<PCB> programs = synthetic_workload(1024);
+
+    // the default layout and a large one
+    std::vector<unsigned int> large;
+    for (int i = 0; i < 1024; i++)
+        large.push_back(2 + (i * 37) % 40);
+
+    for (const auto &layout : {default_partition_sizes(), large}) {
+        for (const auto &strategy : strategies) {
+            std::string name = std::string("memory/") + strategy.first + "/" +
+                               std::to_string(layout.size()) +
+                               "_partitions/assign_free";
+            if (name.find(options.filter) == std::string::npos) continue;
+
+            results.push_back(measure(name, options.min_time,
+                [&](unsigned long long iterations) {
+                    memory_manager memory(layout, strategy.second);
+                    std::vector<PCB> held;
+                    held.reserve(programs.size());
+
+                    // keep about half the memory in use
+                    for (unsigned long long i = 0; i < iterations; i++) {
+                        PCB program = programs[i % programs.size()];
+                        if (memory.assign_memory(program))
+                            held.push_back(program);
+                        if (held.size() > layout.size() / 2 || i % 2 == 1) {
+                            if (!held.empty()) {
+                                memory.free_memory(held.back());
+                                held.pop_back();
+                            }
+                        }
+                    }
+                    do_not_optimize(held.size());
+                    return iterations;
+                }));
+        }
+    }
+}
+
+template <typename Queue>
+void bench_queue(const char* name_prefix, const bench_options &options,
+                 std::vector<bench_result> &results) {
+    for (std::size_t n : {16, 1024, 65536}) {
+        std::string name = std::string("ready_queue/") + name_prefix +
+                           "/push_pop/" + std::to_string(n);
+        if (name.find(options.filter) == std::string::npos) continue;
+
+        process_store table(synthetic_workload(n));
+
+        results.push_back(measure(name, options.min_time,
+            [&](unsigned long long iterations) {
+                Queue queue(table);
+                long long sum = 0;
+                for (unsigned long long it = 0; it < iterations; it++) {
+                    for (std::size_t i = 0; i < n; i++)
+                        queue.push(i);
+                    while (!queue.empty())
+                        sum += queue.pop();
+                }
+                do_not_optimize(sum);
+                return iterations * n;
+            }));
+    }
+}
+
+void bench_exec_status(const bench_options &options,
+                       std::vector<bench_result> &results) {
+    if (std::string("exec_status/format_exec_status").find(options.filter) !=
+        std::string::npos) {
+        results.push_back(measure("exec_status/format_exec_status", options.min_time,
+            [](unsigned long long iterations) {
+                char row[EXEC_ROW_MAX];
+                std::size_t total = 0;
+                for (unsigned long long i = 0; i < iterations; i++) {
+                    char* end = format_exec_status(row, i, i % 1000,
+                                                   READY, RUNNING);
+                    total += end - row;
+                }
+                do_not_optimize(total);
+                return iterations;
+            }));
+    }
+
+    if (std::string("exec_status/print_exec_status").find(options.filter) !=
+        std::string::npos) {
+        results.push_back(measure("exec_status/print_exec_status", options.min_time,
+            [](unsigned long long iterations) {
+                std::size_t total = 0;
+                for (unsigned long long i = 0; i < iterations; i++)
+                    total += print_exec_status(i, i % 1000, RUNNING,
+                                               WAITING).size();
+                do_not_optimize(total);
+                return iterations;
+            }));
+    }
+
+    if (std::string("exec_status/log_sink").find(options.filter) !=
+        std::string::npos) {
+        results.push_back(measure("exec_status/log_sink", options.min_time,
+            [](unsigned long long iterations) {
+                std::string captured;
+                log_sink sink;
+                sink.capture(captured);
+                for (unsigned long long i = 0; i < iterations; i++) {
+                    sink.exec_status(i, i % 1000, WAITING, READY);
+                    if (captured.size() > (1 << 22)) captured.clear();
+                }
+                sink.flush();
+                do_not_optimize(captured.size());
+                return iterations;
+            }));
+    }
+}
+
+void bench_input(const bench_options &options, std::vector<bench_result> &results) {
+    const std::string line = "15, 40, 1000, 200, 50, 30, 3";
+
+    if (std::string("input/split_delim_add_process").find(options.filter) !=
+        std::string::npos) {
+        results.push_back(measure("input/split_delim_add_process", options.min_time,
+            [&](unsigned long long iterations) {
+                long long sum = 0;
+                for (unsigned long long i = 0; i < iterations; i++)
+                    sum += add_process(split_delim(line, ",")).size;
+                do_not_optimize(sum);
+                return iterations;
+            }));
+    }
+
+    if (std::string("input/parse_process_line").find(options.filter) !=
+        std::string::npos) {
+        results.push_back(measure("input/parse_process_line", options.min_time,
+            [&](unsigned long long iterations) {
+                long long sum = 0;
+                int fields[9];
+                for (unsigned long long i = 0; i < iterations; i++) {
+                    int count = parse_process_line(line, fields);
+                    sum += add_process(fields, count).size;
+                }
+                do_not_optimize(sum);
+                return iterations;
+            }));
+    }
+}
+
+//Whole simulations, the logs are formatted and written to /dev/null
+void bench_simulation(const bench_options &options,
+                      std::vector<bench_result> &results) {
+    for (std::size_t n = 10; n <= options.max_processes; n *= 10) {
+        std::vector<PCB> workload = synthetic_workload(n);
+
+        for (const char* policy : {"rr", "ep", "ep_rr", "mlfq",
+                                   "sjf", "srtf", "aging"}) {
+            std::string name = std::string("run_simulation/") + policy + "/" +
+                               std::to_string(n);
+            if (name.find(options.filter) == std::string::npos) continue;
+
+            results.push_back(measure(name, options.min_time,
+                [&](unsigned long long iterations) {
+                    for (unsigned long long i = 0; i < iterations; i++) {
+                        log_sink execution_log("/dev/null");
+                        log_sink memory_log("/dev/null");
+                        with_policy(policy, [&](auto p) {
+                            typedef decltype(p) Policy;
+                            do_not_optimize(run_simulation<Policy>(
+                                workload, memory_manager(), execution_log,
+                                memory_log).finish_time);
+                        });
+                    }
+                    return iterations * n;
+                }));
+        }
+    }
+}
+
+// JSON OUTPUT
+void write_json(std::ostream &out, const char* executable,
+                const std::vector<bench_result> &results) {
+    char date[64];
+    std::time_t now = std::time(nullptr);
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S%z", std::localtime(&now));
+
+    out << "{\n  \"context\": {\n"
+        << "    \"date\": \"" << date << "\",\n"
+        << "    \"executable\": \"" << executable << "\",\n"
+        << "    \"num_cpus\": " << std::thread::hardware_concurrency() << ",\n"
+#ifdef __OPTIMIZE__
+        << "    \"library_build_type\": \"release\"\n"
+#else
+        << "    \"library_build_type\": \"debug\"\n"
+#endif
+        << "  },\n  \"benchmarks\": [";
+
+    for (std::size_t i = 0; i < results.size(); i++) {
+        const bench_result &r = results[i];
+        out << (i > 0 ? "," : "") << "\n    {\n"
+            << "      \"name\": \"" << r.name << "\",\n"
+            << "      \"run_type\": \"iteration\",\n"
+            << "      \"iterations\": " << r.iterations << ",\n"
+            << "      \"real_time\": " << r.real_time << ",\n"
+            << "      \"cpu_time\": " << r.cpu_time << ",\n"
+            << "      \"time_unit\": \"ns\"";
+        if (r.items_per_second > 0)
+            out << ",\n      \"items_per_second\": " << r.items_per_second;
+        out << "\n    }";
+    }
+    out << "\n  ]\n}\n";
+}
+
+// MAIN
+int main(int argc, char** argv) {
+
+    bench_options options;
+    std::string out_file;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg.rfind("--filter=", 0) == 0)
+            options.filter = arg.substr(9);
+        else if (arg.rfind("--max-processes=", 0) == 0)
+            options.max_processes = std::stoul(arg.substr(16));
+        else if (arg.rfind("--min-time=", 0) == 0)
+            options.min_time = std::stod(arg.substr(11));
+        else if (arg.rfind("--out=", 0) == 0)
+            out_file = arg.substr(6);
+        else {
+            std::cout << "ERROR!\nUsage: ./bench [--filter=substring] "
+                         "[--max-processes=N] [--min-time=seconds] "
+                         "[--out=results.json]\n";
+            return -1;
+        }
+    }
+
+    std::vector<bench_result> results;
+
+    bench_memory(options, results);
+    bench_queue<fifo_ready_queue>("fifo", options, results);
+    bench_queue<priority_ready_queue<lower_priority_value_first>>(
+        "priority", options, results);
+    bench_queue<mlfq_ready_queue>("mlfq", options, results);
+    bench_queue<priority_ready_queue<shortest_remaining_first>>(
+        "srtf", options, results);
+    bench_queue<priority_ready_queue<aged_priority_first<100>>>(
+        "aging", options, results);
+    bench_exec_status(options, results);
+    bench_input(options, results);
+    bench_simulation(options, results);
+
+    if (out_file.empty()) {
+        write_json(std::cout, argv[0], results);
+        return 0;
+    }
+
+    std::ofstream out(out_file);
+    if (!out.is_open()) {
+        std::cerr << "Error opening file!\n";
+        return -1;
+    }
+    write_json(out, argv[0], results);
+    return 0;
+}
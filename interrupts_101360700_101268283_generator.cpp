@@ -0,0 +1,254 @@
+/**
+ * @file generator.cpp
+ * @author Nawal Musameh, Shahd Elsaman
+ * Writes a synthetic input file ("PID, size, arrival, cpu, io_freq,
+ * io_duration, priority" per line) from seeded distributions:
+ *   arrivals      Poisson process, --arrival-mean ms between arrivals
+ *   CPU bursts    --burst=exp:<mean> or --burst=pareto:<alpha>:<min>
+ *                 (heavy tailed, capped at --max-burst)
+ *   memory sizes  bimodal over the partition layout: --small-fraction of
+ *                 the processes fit the smaller half of the partitions,
+ *                 the rest the larger half
+ *   priorities    Zipf over 0..--priorities-1 with exponent --zipf
+ *   I/O           --io-fraction of the processes do I/O every io_freq ms
+ *                 (exponential, mean --io-freq-mean) for io_duration ms
+ *                 (exponential, mean --io-duration-mean)
+ * Lines are streamed through a buffered sink, so any number of processes
+ * can be generated in constant memory. Every field stays within an int,
+ * as the simulator reads them; generation stops with an error once the
+ * arrival times pass INT_MAX ms. Usage:
+ *   ./generate_workload --processes=N [--seed=1] [--out=input.txt]
+ *       [--partitions=40,25,...] [other options above]
+ */
+
+#include "interrupts_101360700_101268283.hpp"
+#include<cmath>
+
+// DISTRIBUTIONS
+struct workload_options {
+    unsigned long long          processes        = 1000;
+    unsigned int                seed             = 1;
+    double                      arrival_mean     = 100;     // ms
+    bool                        pareto_bursts    = false;
+    double                      burst_mean       = 150;     // exp:<mean>
+    double                      pareto_alpha     = 1.5;     // pareto:<alpha>:<min>
+    double                      pareto_min       = 20;
+    unsigned int                max_burst        = 100000;
+    double                      small_fraction   = 0.7;
+    unsigned int                priorities       = 10;
+    double                      zipf             = 1.0;
+    double                      io_fraction      = 0.5;
+    double                      io_freq_mean     = 50;
+    double                      io_duration_mean = 20;
+    std::vector<unsigned int>   partition_sizes  = default_partition_sizes();
+};
+
+//Zipf(s) over 0..n-1 through its cumulative distribution, rank 0 is the
+//most likely
+class zipf_distribution {
+public:
+    zipf_distribution(unsigned int n, double s) {
+        double total = 0;
+        for (unsigned int k = 1; k <= n; k++) {
+            total += 1.0 / std::pow(k, s);
+            cdf.push_back(total);
+        }
+        for (double &c : cdf) c /= total;
+    }
+
+    template <typename Random>
+    unsigned int operator()(Random &random) {
+        double u = std::uniform_real_distribution<double>(0, 1)(random);
+        auto rank = std::lower_bound(cdf.begin(), cdf.end(), u) - cdf.begin();
+        return std::min<std::size_t>(rank, cdf.size() - 1);
+    }
+
+private:
+    std::vector<double> cdf;
+};
+
+class workload_generator {
+public:
+    explicit workload_generator(const workload_options &options)
+        : options(options),
+          random(options.seed),
+          priority(std::max(1u, options.priorities), options.zipf),
+          partitions(options.partition_sizes) {
+        std::sort(partitions.begin(), partitions.end());
+    }
+
+    //Fields of the next process, false once the arrival time no longer
+    //fits in an int
+    bool next(unsigned long long pid, long long* fields) {
+        arrival += std::exponential_distribution<double>(
+            1.0 / options.arrival_mean)(random);
+        if (arrival > INT_MAX) return false;
+
+        bool io = uniform() < options.io_fraction;
+
+        fields[0] = pid;
+        fields[1] = memory_size();
+        fields[2] = arrival;
+        fields[3] = burst();
+        fields[4] = io ? 1 + exponential(options.io_freq_mean) : 0;
+        fields[5] = io ? 1 + exponential(options.io_duration_mean) : 0;
+        fields[6] = priority(random);
+        return true;
+    }
+
+private:
+    double uniform() {
+        return std::uniform_real_distribution<double>(0, 1)(random);
+    }
+
+    unsigned int exponential(double mean) {
+        return std::min<double>(
+            std::exponential_distribution<double>(1.0 / mean)(random), INT_MAX - 1);
+    }
+
+    // CPU burst, at least 1 ms
+    unsigned int burst() {
+        double ms;
+        if (options.pareto_bursts)
+            ms = options.pareto_min /
+                 std::pow(1.0 - uniform(), 1.0 / options.pareto_alpha);
+        else
+            ms = 1 + exponential(options.burst_mean);
+        return std::max(1.0, std::min<double>(ms, options.max_burst));
+    }
+
+    // a size that fits a partition of the small or the large half, and
+    // not the next smaller one, so placement decisions matter
+    unsigned int memory_size() {
+        std::size_t half = (partitions.size() + 1) / 2;
+        std::size_t i = (uniform() < options.small_fraction || half == partitions.size())
+            ? std::uniform_int_distribution<std::size_t>(0, half - 1)(random)
+            : std::uniform_int_distribution<std::size_t>(half,
+                                                         partitions.size() - 1)(random);
+
+        unsigned int low = (i > 0) ? partitions[i - 1] + 1 : 1;
+        unsigned int high = std::min<unsigned int>(std::max(partitions[i], 1u),
+                                                   INT_MAX);
+        return std::uniform_int_distribution<unsigned int>(std::min(low, high),
+                                                           high)(random);
+    }
+
+    workload_options    options;
+    std::mt19937_64     random;
+    zipf_distribution   priority;
+    std::vector<unsigned int> partitions;   // sorted
+    double              arrival = 0;
+};
+
+// ARGUMENTS
+//"exp:<mean>" or "pareto:<alpha>:<min>"
+bool parse_burst(const std::string &spec, workload_options &options) {
+    std::vector<std::string> fields = split_delim(spec, ":");
+    try {
+        if (fields.size() == 2 && fields[0] == "exp") {
+            options.pareto_bursts = false;
+            options.burst_mean    = std::stod(fields[1]);
+            return options.burst_mean > 0;
+        }
+        if (fields.size() == 3 && fields[0] == "pareto") {
+            options.pareto_bursts = true;
+            options.pareto_alpha  = std::stod(fields[1]);
+            options.pareto_min    = std::stod(fields[2]);
+            return options.pareto_alpha > 0 && options.pareto_min > 0;
+        }
+    } catch (const std::exception &) {}
+    return false;
+}
+
+bool parse_options(int argc, char** argv, workload_options &options,
+                   std::string &out) {
+    try {
+        for (int i = 1; i < argc; i++) {
+            std::string arg = argv[i];
+            std::string value = arg.substr(arg.find('=') + 1);
+
+            if (arg.rfind("--processes=", 0) == 0)
+                options.processes = std::stoull(value);
+            else if (arg.rfind("--seed=", 0) == 0)
+                options.seed = std::stoul(value);
+            else if (arg.rfind("--out=", 0) == 0)
+                out = value;
+            else if (arg.rfind("--arrival-mean=", 0) == 0)
+                options.arrival_mean = std::stod(value);
+            else if (arg.rfind("--burst=", 0) == 0) {
+                if (!parse_burst(value, options)) return false;
+            }
+            else if (arg.rfind("--max-burst=", 0) == 0) {
+                if (!parse_unsigned(value, options.max_burst)) return false;
+            }
+            else if (arg.rfind("--small-fraction=", 0) == 0)
+                options.small_fraction = std::stod(value);
+            else if (arg.rfind("--priorities=", 0) == 0)
+                options.priorities = std::stoul(value);
+            else if (arg.rfind("--zipf=", 0) == 0)
+                options.zipf = std::stod(value);
+            else if (arg.rfind("--io-fraction=", 0) == 0)
+                options.io_fraction = std::stod(value);
+            else if (arg.rfind("--io-freq-mean=", 0) == 0)
+                options.io_freq_mean = std::stod(value);
+            else if (arg.rfind("--io-duration-mean=", 0) == 0)
+                options.io_duration_mean = std::stod(value);
+            else if (arg.rfind("--partitions=", 0) == 0) {
+                if (!parse_partition_spec(value, options.partition_sizes))
+                    return false;
+            }
+            else
+                return false;
+        }
+    } catch (const std::exception &) {
+        return false;
+    }
+
+    return options.arrival_mean > 0 && options.io_freq_mean > 0 &&
+           options.io_duration_mean > 0 && options.max_burst <= INT_MAX;
+}
+
+// MAIN
+int main(int argc, char** argv) {
+
+    workload_options options;
+    std::string out;        // empty: standard output
+
+    if (!parse_options(argc, argv, options, out)) {
+        std::cout << "ERROR!\nUsage: ./generate_workload --processes=N "
+                     "[--seed=1] [--out=input.txt] [--arrival-mean=ms] "
+                     "[--burst=exp:mean|pareto:alpha:min] [--max-burst=ms] "
+                     "[--small-fraction=0.7] [--partitions=40,25,...] "
+                     "[--priorities=10] [--zipf=1.0] [--io-fraction=0.5] "
+                     "[--io-freq-mean=ms] [--io-duration-mean=ms]\n";
+        return -1;
+    }
+
+    std::ios::sync_with_stdio(false);
+    log_sink file_sink(out.empty() ? nullptr : out.c_str());
+    log_sink stdout_sink(std::cout);
+    log_sink &sink = out.empty() ? stdout_sink : file_sink;
+
+    workload_generator generator(options);
+
+    long long fields[7];
+    char line[7 * 24];
+
+    for (unsigned long long pid = 1; pid <= options.processes; pid++) {
+        if (!generator.next(pid, fields)) {
+            std::cerr << "Arrival times pass " << INT_MAX << " ms after "
+                      << pid - 1 << " processes, lower --arrival-mean.\n";
+            return -1;
+        }
+
+        char* end = line;
+        for (int f = 0; f < 7; f++) {
+            if (f > 0) end = pad_field(end, ", ", 2, 2);
+            end = pad_number(end, fields[f], 0);
+        }
+        end = pad_field(end, "\n", 1, 1);
+        sink.write(line, end - line);
+    }
+
+    return 0;
+}
@@ -0,0 +1,60 @@
+/**
+ * @file trace_to_table.cpp
+ * @author Nawal Musameh, Shahd Elsaman
+ * Renders a binary trace written with --trace back into the execution
+ * table (header, one row per transition, footer).
+ */
+
+#include "interrupts_101360700_101268283.hpp"
+
+// MAIN
+int main(int argc, char** argv) {
+
+    if (argc != 3) {
+        std::cout << "ERROR!\nUsage: ./trace_to_table trace.bin execution.txt\n";
+        return -1;
+    }
+
+    std::ifstream trace_file(argv[1], std::ios::binary);
+    if (!trace_file.is_open()) {
+        std::cerr << "Error opening file.\n";
+        return -1;
+    }
+
+    char magic[sizeof(TRACE_MAGIC)];
+    if (!trace_file.read(magic, sizeof(magic)) ||
+        !std::equal(magic, magic + sizeof(magic), TRACE_MAGIC)) {
+        std::cerr << "Not a trace file.\n";
+        return -1;
+    }
+
+    log_sink table(argv[2]);
+    table.write(print_exec_header());
+
+    // read whole chunks of records at a time
+    const std::size_t CHUNK_RECORDS = 4096;
+    std::vector<char> chunk(CHUNK_RECORDS * TRACE_RECORD_SIZE);
+
+    while (trace_file) {
+        trace_file.read(chunk.data(), chunk.size());
+        if (trace_file.gcount() % TRACE_RECORD_SIZE != 0) {
+            std::cerr << "Truncated trace.\n";
+            return -1;
+        }
+        std::size_t records = trace_file.gcount() / TRACE_RECORD_SIZE;
+
+        for (std::size_t i = 0; i < records; i++) {
+            trace_record record;
+            if (!decode_trace_record(chunk.data() + i * TRACE_RECORD_SIZE,
+                                     record)) {
+                std::cerr << "Not a trace file.\n";
+                return -1;
+            }
+            table.exec_status(record.time, record.PID,
+                              record.old_state, record.new_state);
+        }
+    }
+
+    table.write(print_exec_footer());
+    return 0;
+}